@@ -0,0 +1,278 @@
+// compile-benchmark: measures the compile time and the peak memory of the
+// compiler for `_i` and `_i1` of generated literals.
+//
+// usage: compile-benchmark [--sizes N,...] [--repeat N] [--work-dir DIR]
+//                          [--output FILE] -- COMMAND...
+//
+// COMMAND is the command line of the compiler, where `{source}` and
+// `{object}` are replaced with the generated source and its object file:
+//
+//   compile-benchmark --sizes 1024,65536 --
+//       g++ -std=c++20 -Iinclude -c {source} -o {object}
+//
+// The results are written to FILE (or the standard output) in JSON:
+//
+//   { "results": [
+//       { "literal": "none", "size": 0, "seconds": 0.38,
+//         "peak_rss_kb": 89012, "status": 0 },
+//       { "literal": "_i", "size": 1024, "seconds": 0.41,
+//         "peak_rss_kb": 91320, "status": 0 }, ... ] }
+//
+// where "none" is the baseline including only the header, `seconds` is the
+// minimum and `peak_rss_kb` is the maximum of the repetitions, and `status`
+// is the exit status of the compiler (not 0 if the literal failed).
+
+#include "text.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#  include <psapi.h>
+#else
+#  include <spawn.h>
+#  include <sys/resource.h>
+#  include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace
+{
+namespace fs = std::filesystem;
+
+struct options
+{
+  std::vector<std::size_t> sizes = { 1 << 10,  4 << 10,   16 << 10,
+                                     64 << 10, 256 << 10, 1 << 20 };
+  unsigned repeat = 1;
+  fs::path work_dir = fs::temp_directory_path() / "unindent-benchmarks";
+  fs::path output;
+  std::vector<std::string> command;
+};
+
+constexpr std::string_view usage =
+    R"(usage: compile-benchmark [--sizes N,...] [--repeat N] [--work-dir DIR]
+                         [--output FILE] -- COMMAND...
+)";
+
+template <class T>
+T
+parse_number(std::string_view str) {
+  T value{};
+  auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+  if (ec != std::errc{} or ptr != str.data() + str.size())
+    throw std::invalid_argument("invalid number: " + std::string(str));
+  return value;
+}
+
+options
+parse_options(std::span<char*> args) {
+  options opts;
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string_view arg = args[i];
+    const bool has_value = i + 1 < args.size();
+    if (arg == "--") {
+      opts.command.assign(args.begin() + i + 1, args.end());
+      break;
+    } else if (arg == "--sizes" and has_value) {
+      opts.sizes.clear();
+      std::string_view list = args[++i];
+      while (not list.empty()) {
+        const auto comma = std::min(list.find(','), list.size());
+        opts.sizes.push_back(parse_number<std::size_t>(list.substr(0, comma)));
+        list.remove_prefix(std::min(comma + 1, list.size()));
+      }
+    } else if (arg == "--repeat" and has_value) {
+      opts.repeat = std::max(1u, parse_number<unsigned>(args[++i]));
+    } else if (arg == "--work-dir" and has_value) {
+      opts.work_dir = args[++i];
+    } else if (arg == "--output" and has_value) {
+      opts.output = args[++i];
+    } else if (arg == "-h" or arg == "--help") {
+      std::cout << usage;
+      std::exit(EXIT_SUCCESS);
+    } else {
+      throw std::invalid_argument("unknown option: " + std::string(arg));
+    }
+  }
+  if (opts.command.empty())
+    throw std::invalid_argument("no compiler command is given");
+  return opts;
+}
+
+// writes a source with `literal` of `size` characters (or only the header
+// if `literal` is "none") to `path`
+void
+write_source(const fs::path& path, std::string_view literal, std::size_t size) {
+  std::ofstream out(path, std::ios::binary);
+  out << "#include <unindent/unindent.hpp>\n";
+  if (literal == "none") {
+    out << "int main() {}\n";
+  } else {
+    // split into raw string literals of at most 8 KB (for MSVC)
+    const std::string text = mitama::unindent::benchmarks::generate_text(size);
+    out << "using namespace mitama::unindent::literals;\n"
+        << "constexpr auto str =";
+    constexpr std::size_t piece = 8 << 10;
+    for (std::size_t pos = 0; pos < text.size(); pos += piece)
+      out << "\n    R\"__(" << text.substr(pos, piece) << ")__\"";
+    out << literal << ";\n"
+        << "int main() { return static_cast<int>(str.size() % 2); }\n";
+  }
+  if (not out)
+    throw std::runtime_error("failed to write " + path.string());
+}
+
+struct measurement
+{
+  double seconds = 0;
+  long peak_rss_kb = -1; // unknown
+  int status = 0;
+};
+
+// runs `argv` and measures the time and the peak memory
+// (of the compiler and its subprocesses)
+measurement
+run(const std::vector<std::string>& argv) {
+  measurement m;
+  const auto start = std::chrono::steady_clock::now();
+#if defined(_WIN32)
+  std::string command_line;
+  for (const auto& arg : argv) {
+    if (not command_line.empty())
+      command_line += ' ';
+    command_line += '"' + arg + '"';
+  }
+  STARTUPINFOA si{ sizeof(si) };
+  PROCESS_INFORMATION pi{};
+  if (not ::CreateProcessA(
+          nullptr, command_line.data(), nullptr, nullptr, FALSE, 0, nullptr,
+          nullptr, &si, &pi
+      ))
+    throw std::runtime_error("failed to run " + argv.front());
+  ::WaitForSingleObject(pi.hProcess, INFINITE);
+  DWORD code = 0;
+  ::GetExitCodeProcess(pi.hProcess, &code);
+  m.status = static_cast<int>(code);
+  PROCESS_MEMORY_COUNTERS counters{};
+  if (::GetProcessMemoryInfo(pi.hProcess, &counters, sizeof(counters)))
+    m.peak_rss_kb = static_cast<long>(counters.PeakWorkingSetSize / 1024);
+  ::CloseHandle(pi.hThread);
+  ::CloseHandle(pi.hProcess);
+#else
+  std::vector<char*> args;
+  for (const auto& arg : argv)
+    args.push_back(const_cast<char*>(arg.c_str()));
+  args.push_back(nullptr);
+  ::pid_t pid = 0;
+  if (::posix_spawnp(&pid, args[0], nullptr, nullptr, args.data(), environ)
+      != 0)
+    throw std::runtime_error("failed to run " + argv.front());
+  int status = 0;
+  ::rusage usage{};
+  ::wait4(pid, &status, 0, &usage); // including the waited-for descendants
+  m.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+#  if defined(__APPLE__)
+  m.peak_rss_kb = usage.ru_maxrss / 1024; // in bytes
+#  else
+  m.peak_rss_kb = usage.ru_maxrss;
+#  endif
+#endif
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  m.seconds = elapsed.count();
+  return m;
+}
+
+// `command` with `{source}` and `{object}` replaced
+std::vector<std::string>
+command_for(
+    const std::vector<std::string>& command, const fs::path& source,
+    const fs::path& object
+) {
+  std::vector<std::string> argv;
+  for (std::string arg : command) {
+    for (auto [key, value] :
+         { std::pair{ std::string_view("{source}"), source.string() },
+           std::pair{ std::string_view("{object}"), object.string() } }) {
+      for (auto pos = arg.find(key); pos != std::string::npos;
+           pos = arg.find(key, pos + value.size()))
+        arg.replace(pos, key.size(), value);
+    }
+    argv.push_back(std::move(arg));
+  }
+  return argv;
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+  try {
+    const auto opts = parse_options(std::span(argv, argc).subspan(1));
+    fs::create_directories(opts.work_dir);
+
+    std::ofstream file;
+    if (not opts.output.empty())
+      file.open(opts.output);
+    std::ostream& out = opts.output.empty() ? std::cout : file;
+
+    out << "{ \"results\": [";
+    bool first = true;
+    auto measure = [&](std::string_view literal, std::size_t size) {
+      const auto name =
+          std::string(literal == "none" ? literal : literal.substr(1)) + '_'
+          + std::to_string(size);
+      const auto source = opts.work_dir / (name + ".cpp");
+      const auto object = opts.work_dir / (name + ".o");
+      write_source(source, literal, size);
+
+      measurement result;
+      result.seconds = -1;
+      for (unsigned i = 0; i < opts.repeat; ++i) {
+        const auto m = run(command_for(opts.command, source, object));
+        if (result.seconds < 0 or m.seconds < result.seconds)
+          result.seconds = m.seconds;
+        result.peak_rss_kb = std::max(result.peak_rss_kb, m.peak_rss_kb);
+        if (m.status != 0)
+          result.status = m.status;
+      }
+      std::clog << literal << ' ' << size << ": " << result.seconds << " s, "
+                << result.peak_rss_kb << " KB"
+                << (result.status == 0 ? "" : " (failed)") << '\n';
+      out << (first ? "\n" : ",\n") << "  { \"literal\": \"" << literal
+          << "\", \"size\": " << size << ", \"seconds\": " << result.seconds
+          << ", \"peak_rss_kb\": " << result.peak_rss_kb
+          << ", \"status\": " << result.status << " }";
+      first = false;
+    };
+
+    measure("none", 0);
+    for (std::string_view literal : { "_i", "_i1" }) {
+      for (auto size : opts.sizes)
+        measure(literal, size);
+    }
+    out << "\n] }\n";
+  } catch (const std::exception& e) {
+    std::cerr << "compile-benchmark: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "text.hpp"
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unindent/batch.hpp>
+#include <unindent/cache.hpp>
+#include <unindent/compressed.hpp>
+#include <unindent/runtime.hpp>
+#include <unindent/stream.hpp>
+#include <unindent/unindent.hpp>
+#include <vector>
+
+namespace
+{
+using namespace mitama::unindent::literals;
+using namespace std::literals;
+
+constexpr auto query = R"(
+  SELECT id, name, email
+    FROM users
+   WHERE id = {}
+     AND name = {}
+)"_i;
+
+// the same string of a different type
+constexpr auto query_copy = mitama::unindent::verbatim<
+    "SELECT id, name, email\n  FROM users\n WHERE id = {}\n   AND name = {}">;
+
+constexpr auto response = R"(
+  HTTP/1.1 {} {}
+  Content-Type: application/json
+  Content-Length: {:>6}
+)"_i;
+
+// a runtime copy of `str` (not known to the optimizer)
+std::string
+copy_of(std::string_view str) {
+  static volatile std::size_t zero = 0;
+  return std::string(str.substr(zero));
+}
+} // namespace
+
+TEST_CASE("edited_string", "[benchmark]") {
+  const auto runtime_query = copy_of(query.to_str());
+
+  BENCHMARK("value()") {
+    return query.value();
+  };
+  BENCHMARK("iteration") {
+    return std::accumulate(query.begin(), query.end(), std::size_t{ 0 });
+  };
+  BENCHMARK("lines()") {
+    std::size_t size = 0;
+    for (auto line : query.lines())
+      size += line.size();
+    return size;
+  };
+  BENCHMARK("== edited_string") {
+    return query == query_copy;
+  };
+  BENCHMARK("== std::string_view") {
+    return query == std::string_view(runtime_query);
+  };
+  BENCHMARK("std::string_view == std::string_view (baseline)") {
+    return query.to_str() == std::string_view(runtime_query);
+  };
+  BENCHMARK("string_hash") {
+    return mitama::unindent::string_hash{}(query);
+  };
+  BENCHMARK("string_hash of std::string_view") {
+    return mitama::unindent::string_hash{}(std::string_view(runtime_query));
+  };
+}
+
+TEST_CASE("format", "[benchmark]") {
+  const auto name = copy_of("John Doe");
+
+  BENCHMARK("format") {
+    return query.format(42, name);
+  };
+  BENCHMARK("std::format (baseline)") {
+    return std::format(
+        "SELECT id, name, email\n  FROM users\n"
+        " WHERE id = {}\n   AND name = {}",
+        42, name
+    );
+  };
+  BENCHMARK("format with specs") {
+    return response.format(200, "OK", 1234);
+  };
+  BENCHMARK("formatted_size") {
+    return query.formatted_size(42, name);
+  };
+
+  std::string buf;
+  BENCHMARK("append_to (reused buffer)") {
+    buf.clear();
+    query.append_to(buf, 42, name);
+    return buf.size();
+  };
+  char out[256];
+  BENCHMARK("format_to_n") {
+    return query.format_to_n(out, sizeof(out), 42, name).size;
+  };
+}
+
+TEST_CASE("compressed", "[benchmark]") {
+  constexpr auto compressed_query = R"(
+    SELECT id, name, email
+      FROM users
+     WHERE id = {}
+       AND name = {}
+  )"_iz;
+  static_cast<void>(compressed_query.value()); // decompressed here
+
+  BENCHMARK("value() (decompressed)") {
+    return compressed_query.value();
+  };
+
+  using query_type = std::remove_const_t<decltype(query)>;
+  constexpr auto& data =
+      mitama::unindent::details::lz::compressed_data<query_type>;
+  std::string buffer(query.size(), '\0');
+  BENCHMARK("decompression") {
+    return mitama::unindent::details::lz::decompress(
+        data.data(), data.size(),
+        reinterpret_cast<unsigned char*>(buffer.data())
+    );
+  };
+}
+
+TEST_CASE("match", "[benchmark]") {
+  const auto method = copy_of("DELETE");
+
+  BENCHMARK("match") {
+    return mitama::unindent::match<
+        "GET"_i, "HEAD"_i, "POST"_i, "PUT"_i, "DELETE"_i, "PATCH"_i>(method);
+  };
+  BENCHMARK("if chain (baseline)") {
+    const std::string_view m = method;
+    for (std::size_t i = 0;
+         auto s : { "GET"sv, "HEAD"sv, "POST"sv, "PUT"sv, "DELETE"sv, "PATCH"sv
+         }) {
+      if (m == s)
+        return i;
+      ++i;
+    }
+    return std::size_t{ 6 };
+  };
+}
+
+TEST_CASE("runtime editors", "[benchmark]") {
+  for (std::size_t size : { 1 << 10, 64 << 10, 1 << 20 }) {
+    const auto text = mitama::unindent::benchmarks::generate_text(size);
+    const auto kb = std::to_string(size >> 10) + " KB";
+    mitama::unindent::indent_meter indent_of_text;
+    indent_of_text.feed(text);
+    const auto indent = indent_of_text.indent();
+
+    BENCHMARK("unindent " + kb) {
+      return mitama::unindent::unindent(text);
+    };
+    BENCHMARK("fold " + kb) {
+      return mitama::unindent::fold(text);
+    };
+    BENCHMARK_ADVANCED("unindent_in_place " + kb)(
+        Catch::Benchmark::Chronometer meter
+    ) {
+      std::vector<std::string> copies(meter.runs(), text);
+      meter.measure([&](int i) {
+        return mitama::unindent::unindent_in_place(copies[i]);
+      });
+    };
+    BENCHMARK("make_stream_unindenter " + kb) {
+      std::string result;
+      auto unindenter = mitama::unindent::make_stream_unindenter(
+          indent, std::back_inserter(result)
+      );
+      constexpr std::size_t chunk = 4096;
+      for (std::size_t pos = 0; pos < text.size(); pos += chunk)
+        unindenter.feed(std::string_view(text).substr(pos, chunk));
+      unindenter.finish();
+      return result;
+    };
+    BENCHMARK("unindent_stream " + kb) {
+      std::istringstream in(text);
+      std::string result;
+      mitama::unindent::unindent_stream(
+          in, indent, std::back_inserter(result)
+      );
+      return result;
+    };
+  }
+}
+
+TEST_CASE("batch", "[benchmark]") {
+  // 40k fragments of about 256 characters
+  std::vector<std::string> fragments;
+  for (std::size_t i = 0; i < 40000; ++i)
+    fragments.push_back(mitama::unindent::benchmarks::generate_text(256));
+  const std::vector<std::string_view> inputs(
+      fragments.begin(), fragments.end()
+  );
+
+  BENCHMARK("unindent of each fragment (baseline)") {
+    std::vector<std::string> results;
+    results.reserve(inputs.size());
+    for (auto input : inputs)
+      results.push_back(mitama::unindent::unindent(input));
+    return results;
+  };
+  BENCHMARK("unindent_batch (1 thread)") {
+    return mitama::unindent::unindent_batch(inputs, 1);
+  };
+  BENCHMARK("unindent_batch") {
+    return mitama::unindent::unindent_batch(inputs);
+  };
+  BENCHMARK("fold_batch") {
+    return mitama::unindent::fold_batch(inputs);
+  };
+}
+
+TEST_CASE("cache", "[benchmark]") {
+  const auto snippet = mitama::unindent::benchmarks::generate_text(1 << 10);
+  mitama::unindent::edit_cache cache(1024);
+  static_cast<void>(cache.unindent(snippet));
+
+  BENCHMARK("unindent 1 KB (baseline)") {
+    return mitama::unindent::unindent(snippet);
+  };
+  BENCHMARK("edit_cache::unindent 1 KB (hit)") {
+    return cache.unindent(snippet).size();
+  };
+}
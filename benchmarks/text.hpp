@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mitama::unindent::benchmarks
+{
+// Returns an indented text of about `size` characters, as the literals of
+// `_i` are (e.g. nested SQL, code or templates): lines of words indented by
+// `indent` spaces and more, with some empty lines.
+//
+// [Note: The text is generated with a fixed seed, so that the literals of
+// the compile-time benchmarks and the strings of the runtime benchmarks are
+// the same for the same size. The text never contains `)__"`, which ends
+// the raw string literals of the generated sources. — end note]
+inline std::string
+generate_text(std::size_t size, std::size_t indent = 4) {
+  constexpr std::string_view words[] = {
+    "SELECT", "FROM",   "WHERE", "JOIN",     "users", "posts",
+    "id",     "name",   "email", "title",    "body",  "created_at",
+    "AND",    "OR",     "NOT",   "NULL",     "=",     "{}",
+    "print",  "return", "if",    "else",     "for",   "value",
+  };
+  std::uint32_t state = 0x2545F491u;
+  auto next = [&state] {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  };
+
+  std::string text = "\n";
+  text.reserve(size + 128);
+  while (text.size() < size) {
+    const auto r = next();
+    if (r % 16 == 0) {
+      text += '\n'; // an empty line
+      continue;
+    }
+    text.append(indent + (r >> 8) % 4 * 2, ' ');
+    const std::size_t count = 3 + (r >> 16) % 8;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i > 0)
+        text += ' ';
+      text += words[next() % std::size(words)];
+    }
+    text += '\n';
+  }
+  text.append(indent / 2, ' '); // the indent of the closing delimiter
+  return text;
+}
+} // namespace mitama::unindent::benchmarks
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unindent/runtime.hpp>
+#include <vector>
+
+namespace mitama::unindent
+{
+// This is the result of the batch editors: the edited strings stored in
+// order in one arena.
+//
+// `batch[i]` is the `i`-th edited string, which is
+// `arena().substr(offsets()[i], offsets()[i + 1] - offsets()[i])`.
+template <typename CharT>
+class basic_batch
+{
+  std::basic_string<CharT> arena_;
+  std::vector<std::size_t> offsets_; // followed by the end of the arena
+
+public:
+  basic_batch() = default;
+
+  basic_batch(
+      std::basic_string<CharT> arena, std::vector<std::size_t> offsets
+  ) noexcept
+      : arena_{ std::move(arena) }, offsets_{ std::move(offsets) } {}
+
+  // the number of the edited strings
+  [[nodiscard]] std::size_t size() const noexcept {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // the `i`-th edited string, where `i < size()`
+  [[nodiscard]] std::basic_string_view<CharT>
+  operator[](std::size_t i) const noexcept {
+    return std::basic_string_view<CharT>(arena_)
+        .substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+
+  // the edited strings joined in order
+  [[nodiscard]] std::basic_string_view<CharT> arena() const noexcept {
+    return arena_;
+  }
+
+  // the offsets of the edited strings in `arena()`
+  // followed by `arena().size()` (empty if `size()` is 0)
+  [[nodiscard]] std::span<const std::size_t> offsets() const noexcept {
+    return offsets_;
+  }
+};
+
+using batch = basic_batch<char>;
+
+namespace details
+{
+  // the size of the inputs edited on a thread at least
+  // (smaller batches are edited on fewer threads)
+  inline constexpr std::size_t batch_bytes_per_job = 64 << 10;
+
+  // runs `task(first, last)` for the ranges [first, last) of [0, count)
+  // on (at most) `jobs` threads, where each thread claims a chunk of
+  // indices at a time until none remains
+  template <class Task>
+  void
+  parallel_chunks(std::size_t count, unsigned jobs, Task task) {
+    if (jobs <= 1 or count <= 1) {
+      task(std::size_t{ 0 }, count);
+      return;
+    }
+    // 8 chunks per thread, so that the threads finishing early take over
+    // the rest of the slower threads
+    const std::size_t chunk = std::max<std::size_t>(1, count / (jobs * 8));
+    std::atomic<std::size_t> next = 0;
+    auto worker = [&] {
+      for (std::size_t first; (first = next.fetch_add(chunk)) < count;)
+        task(first, std::min(first + chunk, count));
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(jobs - 1);
+    for (unsigned i = 1; i < jobs; ++i)
+      threads.emplace_back(worker);
+    worker();
+    threads.clear(); // join
+  }
+
+  // edits `inputs` with `edit(input, out)` (writing the edited string to
+  // `out` and returning its length) into one arena on `jobs` threads
+  // (the number of cores if 0)
+  template <typename CharT, class Edit>
+  basic_batch<CharT> edit_batch(
+      std::span<const std::basic_string_view<CharT>> inputs, unsigned jobs,
+      Edit edit
+  ) {
+    if (inputs.empty())
+      return {};
+
+    // the slot of the `i`-th string is [offsets[i], offsets[i + 1]),
+    // since an edited string is never longer than its input, and
+    // `offsets[n + 1 + i]` is the length of the `i`-th edited string
+    const std::size_t n = inputs.size();
+    std::vector<std::size_t> offsets(n * 2 + 1);
+    for (std::size_t i = 0; i < n; ++i)
+      offsets[i + 1] = offsets[i] + inputs[i].size();
+    std::basic_string<CharT> arena(offsets[n], CharT());
+
+    // phase 1: edit each input into its slot (in parallel)
+    if (jobs == 0)
+      jobs = std::max(1u, std::thread::hardware_concurrency());
+    jobs = static_cast<unsigned>(
+        std::min<std::size_t>(jobs, offsets[n] / batch_bytes_per_job + 1)
+    );
+    parallel_chunks(n, jobs, [&](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i)
+        offsets[n + 1 + i] = edit(inputs[i], arena.data() + offsets[i]);
+    });
+
+    // phase 2: move the edited strings to the front in order
+    // (a string is moved only over the slots of the strings already moved)
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::size_t length = offsets[n + 1 + i];
+      std::char_traits<CharT>::move(
+          arena.data() + size, arena.data() + offsets[i], length
+      );
+      offsets[i] = size;
+      size += length;
+    }
+    offsets[n] = size;
+    offsets.resize(n + 1);
+    arena.resize(size);
+    return { std::move(arena), std::move(offsets) };
+  }
+} // namespace details
+
+// Unindents each string of `inputs` as `unindent` does on `jobs` threads
+// (the number of cores if 0), and returns the results in one arena.
+//
+// [Note: The batch allocates two buffers (instead of a string for each
+// input): the arena, zero-filled to the total size of the inputs, and a
+// table of `2 * size + 1` indices for the offsets and the lengths. The
+// strings are edited directly from the inputs into the arena. The buffers
+// are not shrunk (which would copy them), so they keep these capacities.
+// The threads are started for each call, and batches smaller than 64 KB in
+// total are edited on the calling thread. — end note]
+//
+// Example:
+// ```cpp
+//  std::vector<std::string_view> fragments = load_templates();
+//  auto results = mitama::unindent::unindent_batch(fragments);
+//  for (std::size_t i = 0; i < results.size(); ++i)
+//    register_template(names[i], results[i]);
+// ```
+template <typename CharT>
+[[nodiscard]] inline basic_batch<CharT> unindent_batch(
+    std::span<const std::basic_string_view<CharT>> inputs, unsigned jobs = 0
+) {
+  return details::edit_batch(
+      inputs, jobs, [](std::basic_string_view<CharT> input, CharT* out) {
+        return details::unindent_to<details::simd_scanner>(input, out);
+      }
+  );
+}
+
+// (so that `unindent_batch(fragments)` deduces `char`)
+[[nodiscard]] inline batch
+unindent_batch(std::span<const std::string_view> inputs, unsigned jobs = 0) {
+  return unindent_batch<char>(inputs, jobs);
+}
+
+// Folds each string of `inputs` as `fold` does on `jobs` threads
+// (the number of cores if 0), and returns the results in one arena.
+template <typename CharT>
+[[nodiscard]] inline basic_batch<CharT> fold_batch(
+    std::span<const std::basic_string_view<CharT>> inputs, unsigned jobs = 0
+) {
+  return details::edit_batch(
+      inputs, jobs, [](std::basic_string_view<CharT> input, CharT* out) {
+        const std::size_t size =
+            details::unindent_to<details::simd_scanner>(input, out);
+        return details::fold_to<details::simd_scanner>(
+            std::basic_string_view<CharT>(out, size), out
+        );
+      }
+  );
+}
+
+// (so that `fold_batch(fragments)` deduces `char`)
+[[nodiscard]] inline batch
+fold_batch(std::span<const std::string_view> inputs, unsigned jobs = 0) {
+  return fold_batch<char>(inputs, jobs);
+}
+} // namespace mitama::unindent
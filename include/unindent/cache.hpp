@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unindent/core.hpp>
+#include <unindent/runtime.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace mitama::unindent
+{
+namespace details
+{
+  // the editors of `basic_edit_cache`
+  enum class cached_edit : std::uint8_t { unindent, fold };
+
+  // an edited string cached with its input
+  template <typename CharT>
+  struct cache_entry
+  {
+    cached_edit edit;
+    std::size_t hash;
+    std::basic_string<CharT> input;
+    std::basic_string<CharT> result;
+    // referenced since the clock hand passed (the second chance of CLOCK)
+    mutable std::atomic<bool> referenced = true;
+  };
+} // namespace details
+
+// This is a string edited by `basic_edit_cache`, which shares the cached
+// string with the cache.
+//
+// [Note: The string is kept alive by the object, so that the view is stable
+// as long as the object lives, even if the string is evicted from the cache
+// in the meantime. — end note]
+template <typename CharT>
+class basic_cached_string
+{
+  std::shared_ptr<const details::cache_entry<CharT>> entry_;
+
+public:
+  basic_cached_string() = default;
+
+  explicit basic_cached_string(
+      std::shared_ptr<const details::cache_entry<CharT>> entry
+  ) noexcept
+      : entry_{ std::move(entry) } {}
+
+  // the edited string
+  [[nodiscard]] std::basic_string_view<CharT> view() const noexcept {
+    return entry_ ? std::basic_string_view<CharT>(entry_->result)
+                  : std::basic_string_view<CharT>();
+  }
+
+  operator std::basic_string_view<CharT>() const noexcept {
+    return view();
+  }
+
+  [[nodiscard]] const CharT* data() const noexcept {
+    return view().data();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return view().size();
+  }
+
+  friend bool operator==(
+      const basic_cached_string& lhs, std::basic_string_view<CharT> rhs
+  ) noexcept {
+    return lhs.view() == rhs;
+  }
+};
+
+// the counters of `basic_edit_cache`
+struct cache_stats
+{
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+  std::size_t size = 0; // the number of the cached strings
+};
+
+// This is a thread-safe cache of the runtime editors, which returns the
+// cached result for the same input (compared by its content).
+//
+// [Note: The cache is split into shards by the hash of the input, each of
+// which is locked on its own (shared by the lookups, and exclusively only
+// by the insertions), so that threads editing different strings rarely wait
+// for each other. A shard holds at most `capacity / shards` strings, and
+// evicts one with CLOCK (an approximation of LRU) when it is full. The input
+// is edited outside of the lock. — end note]
+//
+// Example:
+// ```cpp
+//  mitama::unindent::edit_cache cache(4096);
+//
+//  void on_snippet(std::string_view snippet) {
+//    const auto text = cache.unindent(snippet); // edited once per content
+//    render(text.view());
+//  }
+// ```
+template <typename CharT>
+class basic_edit_cache
+{
+  using entry = details::cache_entry<CharT>;
+  using edit = details::cached_edit;
+
+  struct shard
+  {
+    mutable std::shared_mutex mutex;
+    // the slots of the clock and the index of the slot of each hash
+    std::vector<std::shared_ptr<const entry>> slots;
+    std::unordered_map<std::size_t, std::size_t> index;
+    std::size_t hand = 0;
+    std::atomic<std::uint64_t> hits = 0;
+    std::atomic<std::uint64_t> misses = 0;
+    std::atomic<std::uint64_t> evictions = 0;
+  };
+
+  std::size_t shard_count_;
+  std::size_t capacity_; // of a shard
+  std::unique_ptr<shard[]> shards_;
+
+public:
+  // `capacity` strings at most (rounded up to a multiple of `shards`)
+  explicit basic_edit_cache(std::size_t capacity, std::size_t shards = 16)
+      : shard_count_{ std::max<std::size_t>(shards, 1) },
+        capacity_{ std::max<std::size_t>(
+            1, (capacity + shard_count_ - 1) / shard_count_
+        ) },
+        shards_{ std::make_unique<shard[]>(shard_count_) } {}
+
+  // Returns `unindent(str)`, edited only if it is not cached.
+  [[nodiscard]] basic_cached_string<CharT>
+  unindent(std::basic_string_view<CharT> str) {
+    return lookup(edit::unindent, str);
+  }
+
+  // Returns `fold(str)`, edited only if it is not cached.
+  [[nodiscard]] basic_cached_string<CharT>
+  fold(std::basic_string_view<CharT> str) {
+    return lookup(edit::fold, str);
+  }
+
+  // the sums of the counters of the shards
+  [[nodiscard]] cache_stats stats() const {
+    cache_stats result;
+    for (std::size_t i = 0; i < shard_count_; ++i) {
+      const shard& s = shards_[i];
+      result.hits += s.hits.load(std::memory_order_relaxed);
+      result.misses += s.misses.load(std::memory_order_relaxed);
+      result.evictions += s.evictions.load(std::memory_order_relaxed);
+      std::shared_lock lock(s.mutex);
+      result.size += s.slots.size();
+    }
+    return result;
+  }
+
+  // removes all the cached strings (the counters are kept)
+  void clear() {
+    for (std::size_t i = 0; i < shard_count_; ++i) {
+      shard& s = shards_[i];
+      std::unique_lock lock(s.mutex);
+      s.slots.clear();
+      s.index.clear();
+      s.hand = 0;
+    }
+  }
+
+private:
+  static bool matches(
+      const entry& e, edit kind, std::basic_string_view<CharT> str
+  ) noexcept {
+    return e.edit == kind and e.input == str;
+  }
+
+  // the cached entry of `str` in `s` (or null)
+  static std::shared_ptr<const entry> find(
+      const shard& s, std::size_t hash, edit kind,
+      std::basic_string_view<CharT> str
+  ) {
+    const auto it = s.index.find(hash);
+    if (it == s.index.end() or not matches(*s.slots[it->second], kind, str))
+      return nullptr;
+    return s.slots[it->second];
+  }
+
+  basic_cached_string<CharT>
+  lookup(edit kind, std::basic_string_view<CharT> str) {
+    // (not `string_hash`: FNV-1a hashes a byte at a time, which is slower
+    // than editing short strings)
+    const std::size_t hash = std::hash<std::basic_string_view<CharT>>{}(str)
+                             ^ static_cast<std::size_t>(kind);
+    shard& s = shards_[details::mix64(hash) % shard_count_];
+    {
+      std::shared_lock lock(s.mutex);
+      if (auto found = find(s, hash, kind, str)) {
+        found->referenced.store(true, std::memory_order_relaxed);
+        s.hits.fetch_add(1, std::memory_order_relaxed);
+        return basic_cached_string<CharT>(std::move(found));
+      }
+    }
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+
+    auto result = std::make_shared<entry>();
+    result->edit = kind;
+    result->hash = hash;
+    result->input = str;
+    result->result = kind == edit::unindent ? mitama::unindent::unindent(str)
+                                            : mitama::unindent::fold(str);
+
+    std::unique_lock lock(s.mutex);
+    if (auto found = find(s, hash, kind, str))
+      return basic_cached_string<CharT>(std::move(found)); // edited meanwhile
+    insert(s, result);
+    return basic_cached_string<CharT>(std::move(result));
+  }
+
+  // inserts `e` into `s` (locked), evicting an entry if `s` is full
+  void insert(shard& s, std::shared_ptr<const entry> e) {
+    const std::size_t hash = e->hash;
+    if (const auto it = s.index.find(hash); it != s.index.end()) {
+      // the same hash of another input: replaced
+      s.slots[it->second] = std::move(e);
+      return;
+    }
+    if (s.slots.size() < capacity_) {
+      s.index.emplace(hash, s.slots.size());
+      s.slots.push_back(std::move(e));
+      return;
+    }
+    // CLOCK: the first slot not referenced since the hand passed
+    while (s.slots[s.hand]->referenced.exchange(false))
+      s.hand = (s.hand + 1) % s.slots.size();
+    s.index.erase(s.slots[s.hand]->hash);
+    s.index.emplace(hash, s.hand);
+    s.slots[s.hand] = std::move(e);
+    s.hand = (s.hand + 1) % s.slots.size();
+    s.evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+using cached_string = basic_cached_string<char>;
+using edit_cache = basic_edit_cache<char>;
+} // namespace mitama::unindent
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unindent/core.hpp>
+
+namespace mitama::unindent
+{
+namespace details::lz
+{
+  // The compressed format is a sequence of tokens of LZ77:
+  //
+  // - a byte: the literal length `L` (high 4 bits)
+  //   and the match length code `M` (low 4 bits),
+  // - extension bytes of `L` if `L` is 15,
+  // - `L` literal bytes,
+  // - if `M` is not 0 (a match of length `M + 3`):
+  //   extension bytes of `M` if `M` is 15,
+  //   and the offset of the match (2 bytes in little endian).
+  //
+  // Extension bytes are added to the length until a byte other than 255.
+  inline constexpr std::size_t min_match = 4;
+  inline constexpr std::size_t max_offset = 0xFFFF;
+  // the longest literals or match of a token
+  // (to bound the loops of constant evaluation)
+  inline constexpr std::size_t max_run = 0xFFFF;
+  inline constexpr std::size_t hash_bits = 12;
+
+  // the upper bound of the compressed length of `size` bytes
+  constexpr std::size_t
+  bound(std::size_t size) noexcept {
+    return size + size / 255 + (size / max_run + 1) * 8 + 16;
+  }
+
+  template <class Byte>
+  constexpr void
+  put_length(Byte* out, std::size_t& pos, std::size_t extra) noexcept {
+    while (extra >= 255) {
+      out[pos++] = Byte(255);
+      extra -= 255;
+    }
+    out[pos++] = static_cast<Byte>(extra);
+  }
+
+  // writes a token of `l` bytes of `literals` (and a match) to `out` from
+  // `pos`
+  constexpr void
+  put_token(
+      unsigned char* out, std::size_t& pos, const unsigned char* literals,
+      std::size_t l, std::size_t match, std::size_t offset
+  ) noexcept {
+    const std::size_t m = match == 0 ? 0 : match - 3;
+    out[pos++] = static_cast<unsigned char>(
+        (std::min<std::size_t>(l, 15) << 4) | std::min<std::size_t>(m, 15)
+    );
+    if (l >= 15)
+      put_length(out, pos, l - 15);
+    for (std::size_t i = 0; i < l; ++i)
+      out[pos++] = literals[i];
+    if (match != 0) {
+      if (m >= 15)
+        put_length(out, pos, m - 15);
+      out[pos++] = static_cast<unsigned char>(offset & 0xFF);
+      out[pos++] = static_cast<unsigned char>(offset >> 8);
+    }
+  }
+
+  // compresses `size` bytes of `in` to `out` (of `bound(size)` bytes at
+  // least), and returns the compressed length
+  //
+  // [Note: Greedy matching with a hash table of 4 bytes. The loops are split
+  // into chunks, so that no loop of constant evaluation iterates more than
+  // `loop_chunk` or `max_run` times. — end note]
+  constexpr std::size_t
+  compress(
+      const unsigned char* in, std::size_t size, unsigned char* out
+  ) noexcept {
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+    std::array<std::size_t, std::size_t{ 1 } << hash_bits> table = {};
+    table.fill(none);
+    const auto hash = [&](std::size_t p) {
+      std::uint32_t v = 0;
+      for (std::size_t i = 0; i < min_match; ++i)
+        v |= static_cast<std::uint32_t>(in[p + i]) << (8 * i);
+      return (v * 2654435761u) >> (32 - hash_bits);
+    };
+
+    std::size_t pos = 0;
+    std::size_t anchor = 0; // the first literal of the current token
+    std::size_t written = 0;
+    while (pos + min_match <= size) {
+      for (std::size_t n = 0; n < loop_chunk and pos + min_match <= size;
+           ++n) {
+        if (pos - anchor == max_run) {
+          put_token(out, written, in + anchor, pos - anchor, 0, 0);
+          anchor = pos;
+        }
+        const auto h = hash(pos);
+        const std::size_t candidate = table[h];
+        table[h] = pos;
+        if (candidate == none or pos - candidate > max_offset
+            or not std::equal(in + pos, in + pos + min_match, in + candidate)) {
+          ++pos;
+          continue;
+        }
+        std::size_t length = min_match;
+        while (pos + length < size and length < max_run
+               and in[candidate + length] == in[pos + length])
+          ++length;
+        put_token(
+            out, written, in + anchor, pos - anchor, length, pos - candidate
+        );
+        pos += length;
+        anchor = pos;
+      }
+    }
+    while (anchor < size) {
+      const std::size_t l = std::min(size - anchor, max_run);
+      put_token(out, written, in + anchor, l, 0, 0);
+      anchor += l;
+    }
+    return written;
+  }
+
+  template <class Byte>
+  constexpr std::size_t
+  get_length(const Byte* in, std::size_t& pos, std::size_t length) noexcept {
+    unsigned char b = 0;
+    do {
+      b = static_cast<unsigned char>(in[pos++]);
+      length += b;
+    } while (b == 255);
+    return length;
+  }
+
+  // decompresses `size` bytes of `in` to `out`,
+  // and returns the decompressed length
+  constexpr std::size_t
+  decompress(
+      const unsigned char* in, std::size_t size, unsigned char* out
+  ) noexcept {
+    std::size_t pos = 0;
+    std::size_t written = 0;
+    while (pos < size) {
+      const unsigned char token = in[pos++];
+      std::size_t literals = token >> 4;
+      if (literals == 15)
+        literals = get_length(in, pos, literals);
+      for (std::size_t i = 0; i < literals; ++i)
+        out[written++] = in[pos++];
+
+      std::size_t match = token & 15;
+      if (match == 0)
+        continue;
+      if (match == 15)
+        match = get_length(in, pos, match);
+      match += 3;
+      const std::size_t offset = in[pos] | (std::size_t{ in[pos + 1] } << 8);
+      pos += 2;
+      // byte by byte, since a match may overlap itself
+      for (std::size_t i = 0; i < match; ++i, ++written)
+        out[written] = out[written - offset];
+    }
+    return written;
+  }
+
+  // the bytes of `S::value()` (in the byte order of the target)
+  template <class S>
+  inline constexpr auto bytes_of = [] {
+    using CharT = typename S::char_type;
+    static_assert(
+        std::endian::native == std::endian::little
+        or std::endian::native == std::endian::big
+    );
+    std::array<unsigned char, S::size() * sizeof(CharT)> bytes = {};
+    std::size_t i = 0;
+    for (const CharT c : S::value()) {
+      const auto u = static_cast<std::make_unsigned_t<CharT>>(c);
+      for (std::size_t b = 0; b < sizeof(CharT); ++b) {
+        const std::size_t shift = std::endian::native == std::endian::little
+                                      ? b
+                                      : sizeof(CharT) - 1 - b;
+        bytes[i++] = static_cast<unsigned char>(u >> (8 * shift));
+      }
+    }
+    return bytes;
+  }();
+
+  // the compressed bytes of `S::value()`
+  template <class S>
+  inline constexpr auto compressed_buffer = [] {
+    constexpr auto& bytes = bytes_of<S>;
+    std::array<unsigned char, bound(bytes.size())> buffer = {};
+    const std::size_t size =
+        compress(bytes.data(), bytes.size(), buffer.data());
+    return std::pair{ buffer, size };
+  }();
+
+  // the compressed bytes of `S::value()` of exactly its length
+  template <class S>
+  inline constexpr auto compressed_data = [] {
+    constexpr auto& compressed = compressed_buffer<S>;
+    std::array<unsigned char, compressed.second> data = {};
+    std::copy_n(compressed.first.begin(), compressed.second, data.begin());
+    return data;
+  }();
+} // namespace details::lz
+
+// This is a class for compressed static storage of result of editing the
+// original string.
+//
+// template parameters:
+// - `Lit`: The non-type template parameter, a `fixed_string` representing the
+// original string.
+// - `Editor`: The non-type template parameter, an editor function of
+// `edited_string`.
+//
+// [Note: The edited string (of `edited_string<Lit, Editor>`) is compressed
+// with LZ77 at compile time, so that only the compressed string is stored
+// in the binary. It is decompressed on the first call of `value()` into
+// a zero-initialized static buffer (thread-safe, and done only once).
+// So `value()` and the members using it are not `constexpr`, unlike
+// `edited_string`, and `format` parses the format string at runtime.
+// — end note]
+template <basic_fixed_string Lit, auto Editor>
+class [[nodiscard]] compressed_string final
+{
+  using edited = edited_string<Lit, Editor>;
+  static constexpr std::size_t size_ = edited::size();
+  static inline std::array<typename edited::char_type, size_ + 1> storage_ =
+      {};
+  using Self = compressed_string;
+
+public:
+  // type members
+  using char_type = typename edited::char_type;
+
+  // static member function
+  // access the value of the edited string (decompressed on the first call)
+  static std::basic_string_view<char_type> value() noexcept {
+    static const bool decompressed = [] {
+      constexpr auto& data = details::lz::compressed_data<edited>;
+      details::lz::decompress(
+          data.data(), data.size(),
+          reinterpret_cast<unsigned char*>(storage_.data())
+      );
+      return true;
+    }();
+    static_cast<void>(decompressed);
+    return std::basic_string_view<char_type>(storage_.data(), size_);
+  }
+
+  // static member function
+  // the length of the edited string (excluding the null terminator)
+  static constexpr std::size_t size() noexcept {
+    return size_;
+  }
+
+  // static member function
+  // the length of the compressed string stored in the binary (in bytes)
+  static constexpr std::size_t compressed_size() noexcept {
+    return details::lz::compressed_data<edited>.size();
+  }
+
+  // static member function
+  // pointer to the null terminated edited string
+  static const char_type* c_str() noexcept {
+    return value().data();
+  }
+
+  // the hash of the edited string, same as `edited_string::hash()`
+  static constexpr std::size_t hash() noexcept {
+    return edited::hash();
+  }
+
+  // Returns formatted string with `std::vformat`
+  //
+  // `s.format(args...)` is same as `std::vformat(s.to_str(),
+  // std::make_format_args(args...))` (or `std::make_wformat_args`).
+  std::basic_string<char_type> format(const auto&... args) const
+    requires details::format_char<char_type>
+  {
+    if constexpr (std::same_as<char_type, char>) {
+      return std::vformat(value(), std::make_format_args(args...));
+    } else {
+      return std::vformat(value(), std::make_wformat_args(args...));
+    }
+  }
+
+  // Returns formatted string allocated with `alloc`,
+  // same as `edited_string::format(std::allocator_arg, alloc, args...)`
+  template <class Allocator>
+  auto format(
+      std::allocator_arg_t, const Allocator& alloc, const auto&... args
+  ) const
+    requires details::format_char<char_type>
+  {
+    details::allocated_string<char_type, Allocator> result(alloc);
+    if constexpr (std::same_as<char_type, char>) {
+      std::vformat_to(
+          std::back_inserter(result), value(), std::make_format_args(args...)
+      );
+    } else {
+      std::vformat_to(
+          std::back_inserter(result), value(), std::make_wformat_args(args...)
+      );
+    }
+    return result;
+  }
+
+  // Returns `std::basic_string_view` of the edited string
+  [[nodiscard]] std::basic_string_view<char_type> to_str() const noexcept {
+    return value();
+  }
+
+  // iterator support
+  auto begin() const noexcept {
+    return Self::value().begin();
+  }
+  auto end() const noexcept {
+    return Self::value().end();
+  }
+
+  // comparison operators
+  inline friend bool
+  operator==(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() == rhs;
+  }
+
+  inline friend auto
+  operator<=>(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() <=> rhs;
+  }
+
+  inline friend std::basic_ostream<char_type>&
+  operator<<(std::basic_ostream<char_type>& os, const Self&) {
+    return os << Self::value();
+  }
+};
+
+template <basic_fixed_string Lit>
+inline constexpr auto compressed = compressed_string<
+    Lit, details::to_unindented>{}; // compressed unindented string
+
+} // namespace mitama::unindent
+
+namespace mitama::unindent::inline literals
+{
+// compressed indent-adjusted multiline string literal
+// This literal operator returns the unindented string stored compressed.
+//
+// Example:
+// ```cpp
+//  constexpr auto schema = R"(
+//    CREATE TABLE users (
+//      id INTEGER PRIMARY KEY,
+//      ...
+//    );
+//  )"_iz;
+//
+//  db.execute(schema.to_str()); // decompressed on the first access
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_iz() {
+  return compressed<S>;
+}
+} // namespace mitama::unindent::inline literals
@@ -0,0 +1,2131 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(UNINDENT_ENABLE_REGISTRY)
+#  include <unindent/registry.hpp>
+#endif
+
+namespace mitama::unindent
+{
+namespace details
+{
+  // the iterations of the inner loops over a whole string in constant
+  // evaluation
+  //
+  // [Note: Loops over the characters of a string are split into chunks, so
+  // that no loop of constant evaluation iterates more than the limit (e.g.
+  // `-fconstexpr-loop-limit`, 262144 by default) for literals of hundreds of
+  // KB. — end note]
+  inline constexpr std::size_t loop_chunk = 4096;
+} // namespace details
+
+// This is a structural type representing a fixed string.
+//
+// template parameters:
+// - `CharT`: a character type of the string literal.
+// - `N`: The non-type template parameter, the size of the string literal.
+//
+// [Note 1: `basic_fixed_string` is initialized with a string literals.
+// In addition, due to CTAD (Class Template Argument Deduction), `CharT` and `N`
+// is automatically deduced. [Example:
+//   ```
+//   constexpr basic_fixed_string fs = "abc"; // basic_fixed_string<char, 4>
+//   ```
+// — end example]
+//
+// ref:
+// https://en.cppreference.com/w/cpp/language/class_template_argument_deduction
+// — end note]
+//
+// [Note 2: Since C++20, `fixed_string` can be used as non-type template
+// arguments with CTAD. [Example:
+//   ```
+//   template <basic_fixed_string S>
+//   struct foo {};
+//
+//   foo<"abc"> f; // foo<basic_fixed_string<char, 4>{"abc"}>
+//   ```
+// — end example]
+//
+// ref: https://timsong-cpp.github.io/cppwp/n4861/temp.arg.nontype#1
+// — end note]
+//
+// [Note 3: Since C++20, structural type can be used as a template parameter
+// of a user-defined literals. [Example:
+//   ```
+//   template <basic_fixed_string S>
+//   inline constexpr auto operator""_fixed() {
+//     return S;
+//   }
+//
+//   "abc"_fixed; // operator""_fixed<"abc">()
+//   ```
+// — end example]
+//
+// ref: https://timsong-cpp.github.io/cppwp/n4861/lex.ext#5
+// -- end Note]
+template <class CharT, std::size_t N>
+struct basic_fixed_string
+{
+  static constexpr std::size_t size = N;
+  using char_type = CharT;
+
+  consteval basic_fixed_string(const CharT (&init)[N + 1])
+      : data{ copy_of(init) } {}
+
+  // initializes with a null terminated array (e.g. built at compile time)
+  consteval basic_fixed_string(const std::array<CharT, N + 1>& init)
+      : data{ init } {}
+
+  auto operator<=>(const basic_fixed_string&) const = default;
+
+  [[nodiscard]] constexpr auto to_str() const {
+    return std::basic_string_view<CharT>(data.data());
+  }
+
+  const std::array<CharT, N + 1> data;
+
+private:
+  // copies `init` in a loop
+  //
+  // [Note: Unlike a pack expansion of `N + 1` elements, the cost of the copy
+  // grows only with the constant evaluation of the loop. — end note]
+  static consteval std::array<CharT, N + 1>
+  copy_of(const CharT (&init)[N + 1]) {
+    std::array<CharT, N + 1> result = {};
+    CharT* out = result.data();
+    for (std::size_t first = 0; first < N + 1; first += details::loop_chunk) {
+      const std::size_t last = std::min(N + 1, first + details::loop_chunk);
+      for (std::size_t i = first; i < last; ++i)
+        out[i] = init[i];
+    }
+    return result;
+  }
+};
+
+// deduction guide
+template <typename CharT, std::size_t N>
+basic_fixed_string(const CharT (&)[N]) -> basic_fixed_string<CharT, N - 1>;
+
+// alias template
+template <std::size_t N>
+using fixed_string = basic_fixed_string<char, N>;
+
+namespace details
+{
+  // the characters of `First` and `Rest...` joined in order
+  template <basic_fixed_string First, basic_fixed_string... Rest>
+  consteval auto
+  join_chunks() {
+    using CharT = typename decltype(First)::char_type;
+    constexpr std::size_t length = (First.size + ... + Rest.size);
+    std::array<CharT, length + 1> result = {};
+    std::size_t pos = 0;
+    auto append = [&](const auto& chunk, std::size_t size) {
+      for (std::size_t first = 0; first < size; first += loop_chunk) {
+        const std::size_t last = std::min(size, first + loop_chunk);
+        for (std::size_t i = first; i < last; ++i)
+          result[pos++] = chunk[i];
+      }
+    };
+    append(First.data, First.size);
+    (append(Rest.data, Rest.size), ...);
+    return basic_fixed_string<CharT, length>(result);
+  }
+
+  template <class T>
+  concept byte_like = std::same_as<T, char> or std::same_as<T, signed char>
+                      or std::same_as<T, unsigned char>
+                      or std::same_as<T, char8_t> or std::same_as<T, std::byte>;
+
+  // the characters of `Bytes` without a trailing null character
+  template <const auto& Bytes>
+  consteval auto
+  string_of_bytes() {
+    constexpr std::size_t count = std::size(Bytes);
+    constexpr bool terminated =
+        count > 0 and static_cast<unsigned char>(Bytes[count - 1]) == 0;
+    constexpr std::size_t length = count - terminated;
+    std::array<char, length + 1> result = {};
+    for (std::size_t first = 0; first < length; first += loop_chunk) {
+      const std::size_t last = std::min(length, first + loop_chunk);
+      for (std::size_t i = first; i < last; ++i)
+        result[i] = static_cast<char>(Bytes[i]);
+    }
+    return basic_fixed_string<char, length>(result);
+  }
+} // namespace details
+
+// a `basic_fixed_string` of the literals `Chunks...` joined in order
+//
+// [Note: Some compilers limit the length of a string literal (e.g. about 16
+// KB for MSVC's C2026, and 64 KB after the concatenation of adjacent
+// literals), so that a large text is given in several literals. The editors
+// see the joined string, e.g. the indent is that of all the chunks and a
+// chunk may end in the middle of a line, unlike `concat` of edited strings.
+// [Example:
+//   ```
+//   constexpr auto schema = unindented<chunks<
+//       R"(
+//         CREATE TABLE users (
+//           id INTEGER PRIMARY KEY,)",
+//       R"(
+//           name TEXT NOT NULL
+//         );
+//       )">>;
+//   ```
+// — end example] — end note]
+template <basic_fixed_string First, basic_fixed_string... Rest>
+  requires(std::same_as<
+               typename decltype(First)::char_type,
+               typename decltype(Rest)::char_type>
+           and ...)
+inline constexpr auto chunks = details::join_chunks<First, Rest...>();
+
+// a `fixed_string` of the bytes of `Bytes` (an array of `char`,
+// `unsigned char`, `char8_t` or `std::byte`), where a trailing null
+// character is dropped
+//
+// [Note: This is for the arrays of `#embed` (C++26, and an extension of
+// Clang and GCC), so that a file is embedded and edited at compile time.
+// [Example:
+//   ```
+//   constexpr unsigned char schema_sql[] = {
+//   #embed "schema.sql"
+//   };
+//   constexpr auto schema = unindented<embedded<schema_sql>>;
+//   ```
+// — end example] — end note]
+template <const auto& Bytes>
+  requires details::byte_like<std::remove_cvref_t<decltype(Bytes[0])>>
+inline constexpr auto embedded = details::string_of_bytes<Bytes>();
+
+namespace details
+{
+  // view of the null terminated string in `raw`
+  // (or the whole array if there is no null character)
+  template <typename CharT, std::size_t N>
+  constexpr std::basic_string_view<CharT>
+  view_of(const std::array<CharT, N>& raw) noexcept {
+    const CharT* data = raw.data();
+    std::size_t size = 0;
+    while (size < N and data[size] != CharT{}) {
+      const std::size_t last = std::min(N, size + loop_chunk);
+      while (size < last and data[size] != CharT{})
+        ++size;
+    }
+    return std::basic_string_view<CharT>(raw.data(), size);
+  }
+
+  // strips leading returns and trailing spaces and returns
+  template <typename CharT>
+  constexpr std::basic_string_view<CharT>
+  trim_returns(std::basic_string_view<CharT> str) noexcept {
+    std::size_t first = 0;
+    std::size_t last = str.size();
+    while (first < last and str[first] == CharT('\n'))
+      ++first;
+    while (last > first
+           and (str[last - 1] == CharT(' ') or str[last - 1] == CharT('\n')))
+      --last;
+    return str.substr(first, last - first);
+  }
+
+  // FNV-1a hash of `str` (of the bytes of each character in little endian)
+  template <typename CharT>
+  constexpr std::size_t
+  fnv1a(std::basic_string_view<CharT> str) noexcept {
+    using hash_type = std::conditional_t<
+        sizeof(std::size_t) >= 8, std::uint64_t, std::uint32_t>;
+    hash_type hash = 0x811c9dc5;
+    hash_type prime = 0x01000193;
+    if constexpr (sizeof(hash_type) == 8) {
+      hash = 0xcbf29ce484222325;
+      prime = 0x100000001b3;
+    }
+    for (std::size_t first = 0; first < str.size(); first += loop_chunk) {
+      const std::size_t last = std::min(str.size(), first + loop_chunk);
+      for (std::size_t pos = first; pos < last; ++pos) {
+        std::uint64_t bits =
+            static_cast<std::make_unsigned_t<CharT>>(str.data()[pos]);
+        for (std::size_t i = 0; i < sizeof(CharT); ++i, bits >>= 8) {
+          hash ^= static_cast<hash_type>(bits & 0xFF);
+          hash *= prime;
+        }
+      }
+    }
+    return static_cast<std::size_t>(hash);
+  }
+
+  // character scanning of the editors
+  //
+  // [Note: The runtime editors use a SIMD implementation of the same
+  // interface (see `unindent/runtime.hpp`). — end note]
+  struct scalar_scanner
+  {
+    // the position of the first return in `str` from `pos`
+    // (or `str.size()` if there is no return)
+    template <typename CharT>
+    static constexpr std::size_t
+    find_return(std::basic_string_view<CharT> str, std::size_t pos) noexcept {
+      // (a pointer is cheaper than `operator[]` in constant evaluation)
+      const CharT* data = str.data();
+      const std::size_t size = str.size();
+      while (pos < size and data[pos] != CharT('\n'))
+        ++pos;
+      return pos;
+    }
+
+    // the number of consecutive spaces in `str` from `pos` (at most `limit`)
+    template <typename CharT>
+    static constexpr std::size_t count_spaces(
+        std::basic_string_view<CharT> str, std::size_t pos, std::size_t limit
+    ) noexcept {
+      limit = std::min(limit, str.size() - pos);
+      const CharT* data = str.data() + pos;
+      std::size_t count = 0;
+      while (count < limit and data[count] == CharT(' '))
+        ++count;
+      return count;
+    }
+  };
+
+  // the minimum indent size of the lines in `str` (except empty lines)
+  template <class Scanner = scalar_scanner, typename CharT>
+  constexpr std::size_t
+  min_indent(std::basic_string_view<CharT> str) noexcept {
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    std::size_t min = none;
+    std::size_t pos = 0;
+    const std::size_t size = str.size();
+
+    while (pos < size and min > 0) {
+      const std::size_t indent = Scanner::count_spaces(str, pos, min);
+      pos += indent;
+      if (pos == size or str[pos] != CharT('\n')) {
+        // non-empty line (only spaces beyond the current minimum are skipped)
+        min = indent;
+        pos = Scanner::find_return(str, pos);
+      } else if (indent > 0) {
+        // a line of spaces only is not an empty line
+        min = indent;
+      }
+      ++pos; // skip the return
+    }
+    return min == none ? 0 : min;
+  }
+
+  // writes `str` without leading returns, trailing spaces and returns,
+  // and the minimum indent of its lines to `out`,
+  // and returns the number of characters written.
+  //
+  // [Note: The output is never longer than `str`,
+  // and `out[i]` is written only after `str[i]` is read,
+  // so that `out` may point to the first character of `str`. — end note]
+  template <class Scanner = scalar_scanner, typename CharT>
+  constexpr std::size_t
+  unindent_to(std::basic_string_view<CharT> str, CharT* out) noexcept {
+    str = trim_returns(str);
+    const std::size_t indent = min_indent<Scanner>(str);
+    const std::size_t size = str.size();
+    std::size_t index = 0;
+    std::size_t pos = 0;
+
+    while (pos < size) {
+      // remove indent (lines shorter than indent are empty lines)
+      pos += Scanner::count_spaces(str, pos, indent);
+      const std::size_t end = Scanner::find_return(str, pos);
+      if (std::is_constant_evaluated()) {
+        // (`char_traits::move` checks the overlap in a loop)
+        const CharT* data = str.data();
+        for (; pos < end; ++pos)
+          out[index++] = data[pos];
+      } else {
+        std::char_traits<CharT>::move(out + index, str.data() + pos, end - pos);
+        index += end - pos;
+        pos = end;
+      }
+      if (pos < size)
+        out[index++] = str[pos++]; // return
+    }
+    return index;
+  }
+
+  // writes the folded `str` (the result of `unindent_to`) to `out`,
+  // and returns the number of characters written.
+  //
+  // [Note: Same as `fold_lines`, but the lines are copied at once. `out` may
+  // point to the first character of `str` as in `unindent_to`. — end note]
+  template <class Scanner = scalar_scanner, typename CharT>
+  constexpr std::size_t
+  fold_to(std::basic_string_view<CharT> str, CharT* out) noexcept {
+    const std::size_t size = str.size();
+    std::size_t index = 0;
+    std::size_t pos = 0;
+
+    while (pos < size) {
+      const std::size_t end = Scanner::find_return(str, pos);
+      if (std::is_constant_evaluated()) {
+        const CharT* data = str.data();
+        for (; pos < end; ++pos)
+          out[index++] = data[pos];
+      } else {
+        std::char_traits<CharT>::move(out + index, str.data() + pos, end - pos);
+        index += end - pos;
+        pos = end;
+      }
+
+      // Replace multiple returns with a single return
+      // and replace a single return with a space.
+      std::size_t returns = 0;
+      while (pos < size and str[pos] == CharT('\n')) {
+        ++returns;
+        ++pos;
+      }
+      if (pos == size) {
+        break; // trailing returns are removed
+      } else if (returns > 1) {
+        out[index++] = CharT('\n');
+      } else if (returns == 1) {
+        out[index++] = CharT(' ');
+      }
+    }
+    return index;
+  }
+  // editor function for unindented string
+  inline constexpr auto to_unindented =
+      []<typename CharT, std::size_t N>(std::array<CharT, N> raw) consteval {
+        std::array<CharT, N> buffer = {};
+        unindent_to(view_of(raw), buffer.data());
+        return buffer;
+      };
+
+  // editor function keeping the original string as it is
+  inline constexpr auto as_is =
+      []<typename CharT, std::size_t N>(std::array<CharT, N> raw) consteval {
+        return raw;
+      };
+
+  template <std::size_t I>
+  using stage_index = std::integral_constant<std::size_t, I>;
+
+  // `Stage` edits a whole string at once with `stage.edit_to(str, out)`
+  // (as its `feed` does a character at a time)
+  template <class Stage, typename CharT>
+  concept whole_string_stage = requires(
+      const Stage& stage, std::basic_string_view<CharT> str, CharT* out
+  ) {
+    { stage.edit_to(str, out) } -> std::same_as<std::size_t>;
+  };
+
+  // writes `str` edited by the per-character `stages` in one scan to `out`,
+  // and returns the number of characters written.
+  //
+  // [Note: `out` may point to the first character of `str`, since a stage
+  // never emits more characters than it consumes. A stage alone is applied
+  // with its `edit_to` if any, which is much cheaper in constant evaluation
+  // than a call per character. — end note]
+  template <typename CharT, class... Stages>
+  constexpr std::size_t scan_stages_to(
+      std::basic_string_view<CharT> str, CharT* out, const Stages&... stages
+  ) {
+    if constexpr (sizeof...(Stages) == 1
+                  and (whole_string_stage<Stages, CharT> and ...)) {
+      return (stages.edit_to(str, out), ...);
+    }
+    std::size_t index = 0;
+    auto chain = std::forward_as_tuple(stages...);
+    std::tuple<typename Stages::state...> states{};
+
+    // feeds `c` to the `I`-th stage, whose output goes to the next one
+    auto feed = [&]<std::size_t I>(
+                    stage_index<I>, auto& self, CharT c
+                ) constexpr -> void {
+      if constexpr (I == sizeof...(Stages)) {
+        out[index++] = c;
+      } else {
+        std::get<I>(chain).feed(std::get<I>(states), c, [&](CharT d) {
+          self(stage_index<I + 1>{}, self, d);
+        });
+      }
+    };
+    for (auto c : str)
+      feed(stage_index<0>{}, feed, c);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (std::get<I>(chain).finish(
+           std::get<I>(states),
+           [&](CharT d) { feed(stage_index<I + 1>{}, feed, d); }
+       ),
+       ...);
+    }(std::index_sequence_for<Stages...>{});
+    return index;
+  }
+
+  // applies the per-character `stages` to `input` in one scan
+  template <typename CharT, std::size_t N, class... Stages>
+  constexpr std::array<CharT, N>
+  scan_stages(const std::array<CharT, N>& input, const Stages&... stages) {
+    if constexpr (sizeof...(Stages) == 0) {
+      return input;
+    } else {
+      std::array<CharT, N> buffer = {};
+      scan_stages_to(view_of(input), buffer.data(), stages...);
+      return buffer;
+    }
+  }
+} // namespace details
+
+// This is a base class of per-character editor stages.
+//
+// template parameters:
+// - `Derived`: The stage class derived from `char_stage<Derived>`.
+//
+// [Note: A per-character stage edits a string by looking at one character at a
+// time, and `Derived` must have the following members:
+//
+//  ```
+//  struct state;                                      // default constructible
+//  constexpr void feed(state&, CharT c, auto emit) const;  // consumes `c`
+//  constexpr void finish(state&, auto emit) const;    // at the end of string
+//  ```
+//
+//  where `emit(c)` appends `c` to the result. A stage must not emit more
+//  characters than it consumes.
+//
+//  `char_stage<Derived>` makes the stage an `Editor` of `edited_string`, and
+//  adjacent per-character stages in `compose<Editors...>` are fused into one
+//  scan of the string. [Example:
+//    ```
+//    struct strip_trailing_spaces : char_stage<strip_trailing_spaces> {
+//      struct state { std::size_t spaces = 0; };
+//
+//      template <typename CharT>
+//      constexpr void feed(state& st, CharT c, auto emit) const {
+//        if (c == ' ') {
+//          ++st.spaces;
+//          return;
+//        }
+//        if (c != '\n') {
+//          for (; st.spaces > 0; --st.spaces)
+//            emit(CharT(' '));
+//        }
+//        st.spaces = 0;
+//        emit(c);
+//      }
+//
+//      constexpr void finish(state&, auto) const {}
+//    };
+//    ```
+//  — end example] — end note]
+template <class Derived>
+struct char_stage
+{
+  template <typename CharT, std::size_t N>
+  consteval auto operator()(std::array<CharT, N> raw) const {
+    return details::scan_stages(raw, static_cast<const Derived&>(*this));
+  }
+};
+
+namespace details
+{
+  template <class T>
+  concept per_char_stage = std::derived_from<
+      std::remove_cvref_t<T>,
+      char_stage<std::remove_cvref_t<T>>>;
+
+  // applies `Editors...` to `buffer` in order,
+  // where `pending` are the per-character stages not yet applied.
+  template <
+      auto Editor,
+      auto... Editors,
+      typename CharT,
+      std::size_t N,
+      class... Pending>
+  consteval auto
+  apply_editors(
+      const std::array<CharT, N>& buffer, std::tuple<Pending...> pending
+  ) {
+    if constexpr (per_char_stage<decltype(Editor)>) {
+      auto stages = std::tuple_cat(pending, std::tuple{ Editor });
+      if constexpr (sizeof...(Editors) == 0) {
+        return std::apply(
+            [&](const auto&... s) { return scan_stages(buffer, s...); }, stages
+        );
+      } else {
+        return apply_editors<Editors...>(buffer, stages);
+      }
+    } else {
+      auto edited = Editor(std::apply(
+          [&](const auto&... s) { return scan_stages(buffer, s...); }, pending
+      ));
+      if constexpr (sizeof...(Editors) == 0) {
+        return edited;
+      } else {
+        return apply_editors<Editors...>(edited, std::tuple<>{});
+      }
+    }
+  }
+
+  // editor function applying `Editors...` in order
+  // (see `compose` for details)
+  template <auto... Editors>
+  struct composed
+  {
+    template <typename CharT, std::size_t N>
+    consteval auto operator()(std::array<CharT, N> raw) const {
+      if constexpr (sizeof...(Editors) == 0) {
+        return raw;
+      } else {
+        return apply_editors<Editors...>(raw, std::tuple<>{});
+      }
+    }
+  };
+
+  // editor stage for folded string
+  // (applied to the result of `to_unindented`)
+  struct folding : char_stage<folding>
+  {
+    struct state
+    {
+      std::size_t returns = 0;
+    };
+
+    template <typename CharT>
+    constexpr void feed(state& st, CharT c, auto emit) const {
+      if (c == CharT('\n')) {
+        st.returns++;
+        return;
+      }
+      // Replace multiple returns with a single return
+      // and replace a single return with a space.
+      if (st.returns > 1) {
+        emit(CharT('\n'));
+      } else if (st.returns == 1) {
+        emit(CharT(' '));
+      }
+      st.returns = 0; // reset here
+      emit(c);
+    }
+
+    // trailing returns are removed
+    constexpr void finish(state&, auto) const {}
+
+    // (the lines are copied at once)
+    template <typename CharT>
+    constexpr std::size_t
+    edit_to(std::basic_string_view<CharT> str, CharT* out) const noexcept {
+      return fold_to(str, out);
+    }
+  };
+
+  inline constexpr folding fold_lines{};
+
+  template <class, class>
+  struct is_char_array : std::false_type
+  {};
+  template <class CharT, std::size_t N>
+  struct is_char_array<std::array<CharT, N>, CharT> : std::true_type
+  {};
+
+  // `T` is `std::array<CharT, M>` for some `M`
+  template <class T, class CharT>
+  concept char_array_of = is_char_array<std::remove_cvref_t<T>, CharT>::value;
+
+  // phase 1: the result of `Editor` in the buffer returned by `Editor`.
+  //
+  // [Note: This variable is only used in constant evaluation, so that the
+  // buffer (usually as large as the original string) is not emitted as long
+  // as it is not odr-used. Since it is a variable template, the edit is
+  // evaluated once per literal and editor in a translation unit. — end note]
+  template <
+      basic_fixed_string Lit,
+      auto Editor,
+      class = std::remove_cvref_t<decltype(Editor)>>
+  inline constexpr auto edit_buffer = Editor(Lit.data);
+
+  // the unindented string of `Lit`, shared by editors built on top of it
+  template <basic_fixed_string Lit>
+  inline constexpr auto unindented_buffer = edit_buffer<Lit, to_unindented>;
+
+  // The result of the first editor is shared with the other editors
+  // starting with it (e.g. `to_unindented`).
+  template <basic_fixed_string Lit, auto Editor, auto First, auto... Rest>
+    requires(!per_char_stage<decltype(First)>)
+  inline constexpr auto edit_buffer<Lit, Editor, composed<First, Rest...>> =
+      composed<Rest...>{}(edit_buffer<Lit, First>);
+
+  // editor function applying `Stage` to the unindented string.
+  //
+  // [Note: Used as `Editor` of `edited_string`, `Stage` is applied to
+  // `unindented_buffer<Lit>`, so that the unindent pass is shared with
+  // `unindented<Lit>` and the other editors built on top of it. [Example:
+  //   ```
+  //   inline constexpr auto to_untabbed =
+  //       details::on_unindented<[]<typename CharT, std::size_t N>(
+  //           std::array<CharT, N> unindented) consteval {
+  //         std::ranges::replace(unindented, '\t', ' ');
+  //         return unindented;
+  //       }>{};
+  //   ```
+  // — end example] — end note]
+  template <auto Stage>
+  using on_unindented = composed<to_unindented, Stage>;
+
+  // the length of the edited string (up to the first null character)
+  template <basic_fixed_string Lit, auto Editor>
+  inline constexpr std::size_t edit_length =
+      view_of(edit_buffer<Lit, Editor>).size();
+
+  // phase 2: copy the first `Len` characters of the edited string
+  // into an array of exactly `Len + 1` (including the null terminator)
+  template <std::size_t Len, typename CharT, std::size_t N>
+  consteval auto
+  shrink_to_fit(const std::array<CharT, N>& buffer) {
+    std::array<CharT, Len + 1> result = {};
+    CharT* out = result.data();
+    const CharT* data = buffer.data();
+    for (std::size_t first = 0; first < Len; first += loop_chunk) {
+      const std::size_t last = std::min(Len, first + loop_chunk);
+      for (std::size_t i = first; i < last; ++i)
+        out[i] = data[i];
+    }
+    return result;
+  }
+
+  // editor function for folded string
+  inline constexpr auto to_folded = on_unindented<fold_lines>{};
+
+  template <typename CharT>
+  constexpr bool is_space(CharT c) noexcept {
+    return c == CharT(' ') or c == CharT('\t') or c == CharT('\n')
+           or c == CharT('\r');
+  }
+
+  // editor stage for minified JSON
+  // (whitespace outside of strings is removed)
+  struct json_minifying : char_stage<json_minifying>
+  {
+    struct state
+    {
+      bool quoted = false;  // in a string
+      bool escaped = false; // after a backslash in a string
+    };
+
+    template <typename CharT>
+    constexpr void feed(state& st, CharT c, auto emit) const {
+      if (st.quoted) {
+        if (st.escaped)
+          st.escaped = false;
+        else if (c == CharT('\\'))
+          st.escaped = true;
+        else if (c == CharT('"'))
+          st.quoted = false;
+        emit(c);
+      } else if (not is_space(c)) {
+        st.quoted = c == CharT('"');
+        emit(c);
+      }
+    }
+
+    constexpr void finish(state&, auto) const {}
+  };
+
+  // editor stage for minified SQL
+  //
+  // [Note: Runs of whitespace and comments outside of quotes (`'...'`,
+  // `"..."` and `` `...` ``) are replaced with a space, which is removed at
+  // both ends and around `(`, `)`, `,` and `;`. Optimizer hints (`/*+ ... */`)
+  // and executable comments (`/*! ... */`) are kept as they are. A backslash
+  // does not escape a quote (as in standard SQL), so that a string with
+  // backslash escapes is minified less but never broken. — end note]
+  struct sql_minifying : char_stage<sql_minifying>
+  {
+    enum class mode : unsigned char
+    {
+      code,
+      quoted,        // in quotes of `quote`
+      line_comment,  // -- ...
+      comment_start, // after /*
+      block_comment, // /* ... */
+      hint,          // /*+ ... */ or /*! ... */
+    };
+
+    struct state
+    {
+      mode m = mode::code;
+      char32_t quote = 0;
+      char32_t held = 0; // `-` or `/`, which may start a comment
+      char32_t last = 0; // the last character of code emitted
+      bool space = false; // a space is pending
+      bool star = false;  // after `*` in a comment
+    };
+
+    template <typename CharT>
+    static constexpr bool is_tight(CharT c) noexcept {
+      return c == CharT('(') or c == CharT(')') or c == CharT(',')
+             or c == CharT(';');
+    }
+
+    // emits the pending space (if needed) and `c` of code
+    template <typename CharT>
+    static constexpr void emit_code(state& st, CharT c, auto emit) {
+      if (st.space and st.last != 0 and not is_tight(CharT(st.last))
+          and not is_tight(c))
+        emit(CharT(' '));
+      st.space = false;
+      st.last = static_cast<char32_t>(c);
+      emit(c);
+    }
+
+    template <typename CharT>
+    constexpr void feed(state& st, CharT c, auto emit) const {
+      switch (st.m) {
+        case mode::quoted:
+          emit(c);
+          if (static_cast<char32_t>(c) == st.quote)
+            st.m = mode::code;
+          return;
+        case mode::line_comment:
+          if (c == CharT('\n'))
+            st.m = mode::code;
+          return;
+        case mode::comment_start:
+          if (c == CharT('+') or c == CharT('!')) {
+            emit_code(st, CharT('/'), emit);
+            emit(CharT('*'));
+            emit(c);
+            st.m = mode::hint;
+            st.star = false;
+          } else {
+            st.m = mode::block_comment;
+            st.star = c == CharT('*');
+          }
+          return;
+        case mode::block_comment:
+          if (st.star and c == CharT('/'))
+            st.m = mode::code;
+          st.star = c == CharT('*');
+          return;
+        case mode::hint:
+          emit(c);
+          if (st.star and c == CharT('/')) {
+            st.m = mode::code;
+            st.last = static_cast<char32_t>(c);
+          }
+          st.star = c == CharT('*');
+          return;
+        case mode::code:
+          break;
+      }
+
+      if (st.held != 0) {
+        const auto held = CharT(st.held);
+        st.held = 0;
+        if (held == CharT('-') and c == CharT('-')) {
+          st.m = mode::line_comment;
+          st.space = true;
+          return;
+        }
+        if (held == CharT('/') and c == CharT('*')) {
+          st.m = mode::comment_start;
+          st.space = true;
+          return;
+        }
+        emit_code(st, held, emit);
+      }
+      if (c == CharT('-') or c == CharT('/')) {
+        st.held = static_cast<char32_t>(c);
+      } else if (is_space(c)) {
+        st.space = true;
+      } else {
+        emit_code(st, c, emit);
+        if (c == CharT('\'') or c == CharT('"') or c == CharT('`')) {
+          st.m = mode::quoted;
+          st.quote = static_cast<char32_t>(c);
+        }
+      }
+    }
+
+    // a held `-` or `/` ends the string
+    constexpr void finish(state& st, auto emit) const {
+      if (st.held != 0)
+        emit_code(st, static_cast<char>(st.held), emit);
+    }
+  };
+
+  // editor function for minified JSON
+  inline constexpr json_minifying to_minified_json{};
+
+  // editor function for minified SQL
+  inline constexpr sql_minifying to_minified_sql{};
+
+  // the number of lines of `str` with contents (except the first line if
+  // `skip_first`)
+  template <typename CharT>
+  constexpr std::size_t count_nonempty_lines(
+      std::basic_string_view<CharT> str, bool skip_first = false
+  ) noexcept {
+    std::size_t count = 0;
+    for (std::size_t pos = 0; pos < str.size(); ++pos) {
+      if (str[pos] != CharT('\n') and not (skip_first and pos == 0))
+        ++count;
+      pos = scalar_scanner::find_return(str, pos);
+    }
+    return count;
+  }
+
+  // editor function for unindented string indented by `K` spaces
+  // (except empty lines)
+  //
+  // [Note: Unlike the other editors, the edited string is longer than the
+  // original one. Used as `Editor` of `edited_string`, the result of
+  // `to_unindented` is shared and the buffer is of exactly the edited
+  // length. — end note]
+  template <std::size_t K>
+  struct indenting
+  {
+    // writes `str` with `K` spaces before each non-empty line to `out`,
+    // and returns the number of characters written
+    template <typename CharT>
+    static constexpr std::size_t
+    indent_to(std::basic_string_view<CharT> str, CharT* out) noexcept {
+      std::size_t index = 0;
+      for (std::size_t pos = 0; pos < str.size(); ++pos) {
+        const std::size_t end = scalar_scanner::find_return(str, pos);
+        if (end > pos) {
+          for (std::size_t i = 0; i < K; ++i)
+            out[index++] = CharT(' ');
+        }
+        for (; pos < end; ++pos)
+          out[index++] = str[pos];
+        if (pos < str.size())
+          out[index++] = CharT('\n');
+      }
+      return index;
+    }
+
+    template <typename CharT, std::size_t N>
+    consteval auto operator()(std::array<CharT, N> raw) const {
+      const auto unindented = to_unindented(raw);
+      std::array<CharT, N * (K + 1)> buffer = {};
+      indent_to(view_of(unindented), buffer.data());
+      return buffer;
+    }
+  };
+
+  template <basic_fixed_string Lit, auto Editor, std::size_t K>
+  inline constexpr auto edit_buffer<Lit, Editor, indenting<K>> = [] {
+    constexpr auto str = view_of(unindented_buffer<Lit>);
+    std::array<
+        typename decltype(Lit)::char_type,
+        str.size() + K * count_nonempty_lines(str) + 1>
+        buffer = {};
+    indenting<K>::indent_to(str, buffer.data());
+    return buffer;
+  }();
+} // namespace details
+
+// This is an editor function applying `Editors...` in order.
+//
+// [Note: `compose<E1, E2, ...>(raw)` is same as `...(E2(E1(raw)))`, but
+// adjacent per-character stages (see `char_stage`) are fused into one scan,
+// so that a chain of them costs about the same as one pass.
+// Used as `Editor` of `edited_string`, the result of `E1` is shared
+// with the other editors starting with `E1`. [Example:
+//   ```
+//   template <basic_fixed_string S>
+//   inline consteval auto operator""_tidy() {
+//     return edited_string<
+//         S, compose<details::to_unindented, strip_trailing_spaces{},
+//                    collapse_blank_lines{}>>{};
+//   }
+//   ```
+// — end example] — end note]
+template <auto... Editors>
+inline constexpr details::composed<Editors...> compose{};
+
+namespace details
+{
+  // the character types of `std::format`
+  template <typename CharT>
+  concept format_char =
+      std::same_as<CharT, char> or std::same_as<CharT, wchar_t>;
+
+  // the string of `CharT` allocated with `Allocator`
+  // (the results of the allocator-aware overloads)
+  template <typename CharT, class Allocator>
+  using allocated_string =
+      std::basic_string<CharT, std::char_traits<CharT>, Allocator>;
+
+  // the number of lines of `str` (0 if `str` is empty)
+  template <typename CharT>
+  constexpr std::size_t
+  count_lines(std::basic_string_view<CharT> str) noexcept {
+    if (str.empty())
+      return 0;
+    std::size_t count = 1;
+    for (std::size_t pos = 0;
+         (pos = scalar_scanner::find_return(str, pos)) < str.size(); ++pos)
+      ++count;
+    return count;
+  }
+
+  // the offsets of the lines of `S::value()` followed by `S::size() + 1`,
+  // so that the `i`-th line is [offsets[i], offsets[i + 1] - 1)
+  template <class S>
+  inline constexpr auto line_offsets_of = [] {
+    constexpr auto str = S::value();
+    std::array<std::size_t, count_lines(str) + 1> offsets = {};
+    std::size_t line = 0;
+    for (std::size_t pos = 0; pos < str.size(); ++pos) {
+      offsets[line++] = pos;
+      pos = scalar_scanner::find_return(str, pos);
+    }
+    // the empty line after a trailing return
+    if (not str.empty() and str.back() == '\n')
+      offsets[line++] = str.size();
+    offsets[line] = str.size() + 1;
+    return offsets;
+  }();
+
+  // This is a random access range of the lines of `S::value()`.
+  template <class S>
+  class line_range
+  {
+  public:
+    using value_type = std::basic_string_view<typename S::char_type>;
+
+    class iterator
+    {
+      std::size_t i_ = 0;
+
+    public:
+      using value_type = line_range::value_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_concept = std::random_access_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+
+      constexpr iterator() noexcept = default;
+      constexpr explicit iterator(std::size_t i) noexcept : i_{ i } {}
+
+      constexpr value_type operator*() const noexcept {
+        return S::line(i_);
+      }
+      constexpr value_type operator[](difference_type n) const noexcept {
+        return S::line(i_ + static_cast<std::size_t>(n));
+      }
+
+      constexpr iterator& operator++() noexcept {
+        ++i_;
+        return *this;
+      }
+      constexpr iterator operator++(int) noexcept {
+        return iterator{ i_++ };
+      }
+      constexpr iterator& operator--() noexcept {
+        --i_;
+        return *this;
+      }
+      constexpr iterator operator--(int) noexcept {
+        return iterator{ i_-- };
+      }
+      constexpr iterator& operator+=(difference_type n) noexcept {
+        i_ += static_cast<std::size_t>(n);
+        return *this;
+      }
+      constexpr iterator& operator-=(difference_type n) noexcept {
+        i_ -= static_cast<std::size_t>(n);
+        return *this;
+      }
+
+      constexpr friend iterator
+      operator+(iterator it, difference_type n) noexcept {
+        return it += n;
+      }
+      constexpr friend iterator
+      operator+(difference_type n, iterator it) noexcept {
+        return it += n;
+      }
+      constexpr friend iterator
+      operator-(iterator it, difference_type n) noexcept {
+        return it -= n;
+      }
+      constexpr friend difference_type
+      operator-(iterator lhs, iterator rhs) noexcept {
+        return static_cast<difference_type>(lhs.i_)
+               - static_cast<difference_type>(rhs.i_);
+      }
+      constexpr friend bool operator==(iterator, iterator) noexcept = default;
+      constexpr friend auto operator<=>(iterator, iterator) noexcept = default;
+    };
+
+    constexpr iterator begin() const noexcept {
+      return iterator{ 0 };
+    }
+    constexpr iterator end() const noexcept {
+      return iterator{ S::line_count() };
+    }
+    constexpr std::size_t size() const noexcept {
+      return S::line_count();
+    }
+    constexpr bool empty() const noexcept {
+      return S::line_count() == 0;
+    }
+    constexpr value_type operator[](std::size_t i) const noexcept {
+      return S::line(i);
+    }
+  };
+
+  // This is a lazy view of `S::value()` with `indent` spaces inserted after
+  // each return (except before empty lines).
+  template <class S>
+  class reindent_view
+  {
+    std::size_t indent_;
+
+    // the number of lines indented by the view
+    static constexpr std::size_t indented_lines =
+        count_nonempty_lines(S::value(), true);
+
+  public:
+    using char_type = typename S::char_type;
+
+    constexpr explicit reindent_view(std::size_t indent) noexcept
+        : indent_{ indent } {}
+
+    // the length of the reindented string
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+      return S::size() + indent_ * indented_lines;
+    }
+
+    // writes the reindented string to `out`,
+    // and returns the iterator past the end of the written string
+    template <class OutputIt>
+    constexpr OutputIt copy_to(OutputIt out) const {
+      for (std::size_t i = 0; i < S::line_count(); ++i) {
+        const auto line = S::line(i);
+        if (i > 0) {
+          *out++ = char_type('\n');
+          if (not line.empty()) {
+            for (std::size_t k = 0; k < indent_; ++k)
+              *out++ = char_type(' ');
+          }
+        }
+        for (const char_type c : line)
+          *out++ = c;
+      }
+      return out;
+    }
+  };
+
+  // This is a value bound to a replacement field at compile time
+  // (an integer, `bool`, a character or a string literal).
+  template <class T>
+  struct bound_value
+  {
+    using type = T;
+    T value;
+
+    template <class U>
+      requires std::constructible_from<T, const U&>
+    consteval bound_value(const U& v) : value{ v } {}
+  };
+
+  template <class T>
+  bound_value(T) -> bound_value<T>;
+
+  template <typename CharT, std::size_t N>
+  bound_value(const CharT (&)[N])
+      -> bound_value<basic_fixed_string<CharT, N - 1>>;
+
+  // the implementation of the format members of `S` (see `edited_string`),
+  // defined in <unindent/format.hpp>
+  template <class S>
+  struct formatting;
+} // namespace details
+
+#if defined(UNINDENT_ENABLE_REGISTRY)
+namespace details
+{
+  // the kind of `Editor` for the registry
+  template <class E>
+  consteval editor_kind
+  kind_of_editor(const E&) noexcept {
+    if constexpr (std::same_as<E, std::remove_const_t<decltype(to_unindented)>>)
+      return editor_kind::unindent;
+    else if constexpr (std::same_as<E, std::remove_const_t<decltype(as_is)>>)
+      return editor_kind::verbatim;
+    else if constexpr (std::same_as<E, json_minifying>)
+      return editor_kind::minified_json;
+    else if constexpr (std::same_as<E, sql_minifying>)
+      return editor_kind::minified_sql;
+    else
+      return editor_kind::custom;
+  }
+
+  template <std::size_t K>
+  consteval editor_kind
+  kind_of_editor(const indenting<K>&) noexcept {
+    return editor_kind::indent;
+  }
+
+  template <auto... Editors>
+  consteval editor_kind
+  kind_of_editor(const composed<Editors...>&) noexcept {
+    // (`to_folded` is composed of `to_unindented` and `fold_lines`)
+    if constexpr (std::same_as<
+                      composed<Editors...>,
+                      std::remove_const_t<decltype(to_folded)>>)
+      return editor_kind::fold;
+    else
+      return editor_kind::composed;
+  }
+
+  // the descriptor of the edited string `S` of a literal of `RawSize`
+  // characters edited with `Editor`
+  template <class S, std::size_t RawSize, auto Editor>
+  UNINDENT_REGISTRY_SECTION inline constexpr registry_entry
+      registry_entry_of = make_registry_entry(
+          kind_of_editor(Editor), RawSize, S::value(), S::hash()
+      );
+} // namespace details
+#endif
+
+// This is a class for static storage of result of editing the original string.
+//
+// template parameters:
+// - `Lit`: The non-type template parameter, a `fixed_string` representing the
+// original string.
+// - `Editor`: The non-type template parameter, a function object specifying how
+// to edit the original string.
+//
+// [Note: `Editor` is a CPO (Customization Point Object) that is a function
+// object. The function object must be a immediate function object that
+// satisfies the following requirements:
+//
+//  ```
+//  requires {
+//    { Editor(Lit.data) } -> details::char_array_of<CharT>;
+//  }
+//  ```
+//
+//  `Lit.data` is a `const std::array` of `CharT` that represents the original
+//  string, and the return value is a `std::array<CharT, M>` of any extent `M`
+//  (e.g. `decltype(Lit.data)` to reuse the size of the original string).
+//  Note that the edited string in the return value must be null terminated,
+//  unless it fills the whole array.
+//
+//  The edit is done in two phases: first `Editor(Lit.data)` is evaluated into
+//  its own buffer and the length of the edited string is computed, then the
+//  edited string is copied into the storage of `edited_string`, which is an
+//  array of exactly that length plus the null terminator. So the static
+//  storage does not depend on how large the buffer of `Editor` is.
+//
+//  To make your own literal operator, you can use `edited_string` as follows:
+//  [Example:
+//    ```
+//    template <mitama::unindent::basic_fixed_string S>
+//    inline consteval auto operator""_xxx() {
+//      return mitama::unindent::edited_string<S, {Your CPO}>{};
+//    }
+//    ```
+//  - end example]
+//
+//  See the `basic_fixed_string` documentation for detailed principles.
+// — end note]
+template <basic_fixed_string Lit, auto Editor>
+  requires requires {
+    {
+      Editor(Lit.data)
+    } -> details::char_array_of<typename decltype(Lit)::char_type>;
+  }
+class [[nodiscard]] edited_string final
+{
+  static constexpr std::size_t size_ = details::edit_length<Lit, Editor>;
+  static constexpr auto value_ =
+      details::shrink_to_fit<size_>(details::edit_buffer<Lit, Editor>);
+  static constexpr std::size_t hash_ = details::fnv1a(
+      std::basic_string_view<typename decltype(Lit)::char_type>(
+          value_.data(), size_
+      )
+  );
+  using Self = edited_string;
+
+public:
+#if defined(UNINDENT_ENABLE_REGISTRY)
+  // puts the descriptor of the string into the binary
+  // (see `registry_entry`)
+  consteval edited_string() noexcept {
+    static_cast<void>(&details::registry_entry_of<Self, Lit.size, Editor>);
+  }
+#endif
+
+  // type members
+  using char_type = decltype(Lit)::char_type;
+
+  // #region comparison operators
+  constexpr inline friend auto
+  operator<=>(std::basic_string_view<char_type> lhs, const Self&) noexcept {
+    return lhs <=> Self::value();
+  }
+
+  constexpr inline friend bool
+  operator!=(std::basic_string_view<char_type> lhs, const Self&) noexcept {
+    return lhs != Self::value();
+  }
+
+  constexpr inline friend bool
+  operator==(std::basic_string_view<char_type> lhs, const Self&) noexcept {
+    return lhs == Self::value();
+  }
+
+  constexpr inline friend bool
+  operator<(std::basic_string_view<char_type> lhs, const Self&) noexcept {
+    return lhs < Self::value();
+  }
+
+  constexpr inline friend bool
+  operator>(std::basic_string_view<char_type> lhs, const Self&) noexcept {
+    return lhs > Self::value();
+  }
+
+  constexpr inline friend auto
+  operator<=>(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() <=> rhs;
+  }
+
+  constexpr inline friend bool
+  operator!=(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() != rhs;
+  }
+
+  constexpr inline friend bool
+  operator==(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() == rhs;
+  }
+
+  constexpr inline friend bool
+  operator<(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() < rhs;
+  }
+
+  constexpr inline friend bool
+  operator>(const Self&, std::basic_string_view<char_type> rhs) noexcept {
+    return Self::value() > rhs;
+  }
+  // #endregion
+
+  // iterator support
+  constexpr auto begin() const noexcept {
+    return Self::value().begin();
+  }
+  constexpr auto end() const noexcept {
+    return Self::value().end();
+  }
+  constexpr auto cbegin() const noexcept {
+    return Self::value().cbegin();
+  }
+  constexpr auto cend() const noexcept {
+    return Self::value().cend();
+  }
+  constexpr auto rbegin() const noexcept {
+    return Self::value().rbegin();
+  }
+  constexpr auto rend() const noexcept {
+    return Self::value().rend();
+  }
+  constexpr auto crbegin() const noexcept {
+    return Self::value().crbegin();
+  }
+  constexpr auto crend() const noexcept {
+    return Self::value().crend();
+  }
+
+  // static member function
+  // access the value of the edited_string string
+  //
+  // [Note: The view is built from the pointer and the precomputed length,
+  // so that it never scans for the null terminator. — end note]
+  static constexpr std::basic_string_view<char_type> value() noexcept {
+    return std::basic_string_view<char_type>(value_.data(), size_);
+  }
+
+  // static member function
+  // the length of the edited string (excluding the null terminator)
+  static constexpr std::size_t size() noexcept {
+    return size_;
+  }
+
+  // static member function
+  // FNV-1a hash of the edited string, computed at compile time
+  // (same as `string_hash{}(value())`)
+  static constexpr std::size_t hash() noexcept {
+    return hash_;
+  }
+
+  // static member function
+  // pointer to the edited string
+  static constexpr const char_type* data() noexcept {
+    return value_.data();
+  }
+
+  // static member function
+  // pointer to the null terminated edited string
+  static constexpr const char_type* c_str() noexcept {
+    return value_.data();
+  }
+
+  // static member function
+  // the number of lines of the edited string (0 if it is empty)
+  static constexpr std::size_t line_count() noexcept {
+    return details::line_offsets_of<Self>.size() - 1;
+  }
+
+  // static member function
+  // the `i`-th line of the edited string (without the return),
+  // where `i < line_count()`
+  //
+  // [Note: The offsets of the lines are computed at compile time,
+  // so that it never scans the string at runtime. — end note]
+  static constexpr std::basic_string_view<char_type>
+  line(std::size_t i) noexcept {
+    constexpr auto& offsets = details::line_offsets_of<Self>;
+    return std::basic_string_view<char_type>(
+        value_.data() + offsets[i], offsets[i + 1] - offsets[i] - 1
+    );
+  }
+
+  // static member function
+  // random access range of the lines of the edited string
+  //
+  // Example:
+  // ```cpp
+  //  constexpr auto body = R"(
+  //    first
+  //    second
+  //  )"_i;
+  //
+  //  for (std::string_view line : body.lines())
+  //    out << "  " << line << '\n';
+  // ```
+  static constexpr details::line_range<Self> lines() noexcept {
+    return {};
+  }
+
+  // Returns formatted string with `std::format`
+  //
+  // `s.format(args...)` is same as `std::format(s.to_str(), args...)`.
+  //
+  // [Note: The format string is split into literal fragments and replacement
+  // fields at compile time, so that only the arguments are formatted at
+  // runtime (`{}` of strings and integers without `std::format`), and the
+  // result is allocated once with `formatted_size(args...)`. Format strings
+  // with nested replacement fields (e.g. `{:{}}`) are passed to `std::format`
+  // as they are. — end note]
+  //
+  // [Note: The format members (`format`, `format_to`, `format_to_n`,
+  // `append_to`, `formatted_size` and `bind`) are defined in
+  // <unindent/format.hpp>. — end note]
+  //
+  // Example:
+  // ```cpp
+  //  constexpr auto fmt = R"(
+  //    def foo():
+  //      print("Hello")
+  //      print("{}")
+  //  )"_i;
+  //
+  //  std::cout << fmt.format("World");
+  //  // Output:
+  //  // def foo():
+  //  //   print("Hello")
+  //  //   print("World")
+  // ```
+  auto format(auto&&... args) const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::format(
+        std::forward<decltype(args)>(args)...
+    );
+  }
+
+  // Returns formatted string allocated with `alloc`
+  // (e.g. `std::pmr::polymorphic_allocator` of an arena).
+  //
+  // `s.format(std::allocator_arg, alloc, args...)` is same as
+  // `s.format(args...)`, but the result is
+  // `std::basic_string<char_type, std::char_traits<char_type>, Allocator>`.
+  //
+  // Example:
+  // ```cpp
+  //  std::pmr::monotonic_buffer_resource arena;
+  //  std::pmr::string str = fmt.format(
+  //      std::allocator_arg, std::pmr::polymorphic_allocator<char>(&arena),
+  //      "World"
+  //  );
+  // ```
+  template <class Allocator>
+  auto format(std::allocator_arg_t, const Allocator& alloc, auto&&... args)
+      const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::format_allocated(alloc, args...);
+  }
+
+  // Writes formatted string to `out` with `std::format_to`,
+  // and returns the iterator past the end of the written string.
+  //
+  // `s.format_to(out, args...)` is same as
+  // `std::format_to(out, s.to_str(), args...)`.
+  //
+  // Example:
+  // ```cpp
+  //  constexpr auto fmt = R"(
+  //    HTTP/1.1 {} {}
+  //    Content-Length: {}
+  //  )"_i;
+  //
+  //  std::array<char, 256> buf;
+  //  auto end = fmt.format_to(buf.begin(), 200, "OK", body.size());
+  // ```
+  template <class OutputIt>
+  OutputIt format_to(OutputIt out, const auto&... args) const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::format_to(std::move(out), args...);
+  }
+
+  // Writes at most `n` characters of formatted string to `out`
+  // with `std::format_to_n`.
+  //
+  // `s.format_to_n(out, n, args...)` is same as
+  // `std::format_to_n(out, n, s.to_str(), args...)`, and the `size` of the
+  // result is the length of the whole formatted string.
+  template <class OutputIt>
+  auto format_to_n(
+      OutputIt out, std::iter_difference_t<OutputIt> n, const auto&... args
+  ) const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::format_to_n(std::move(out), n, args...);
+  }
+
+  // Appends formatted string to `out`.
+  //
+  // [Note: Unlike `format`, no string is allocated, so that a buffer
+  // reused with `clear()` keeps its capacity and is reallocated only when
+  // the formatted string is longer than ever. — end note]
+  //
+  // Example:
+  // ```cpp
+  //  thread_local std::string buf;
+  //  buf.clear();
+  //  fmt.append_to(buf, 200, "OK", body.size());
+  // ```
+  template <class Traits, class Allocator>
+  void append_to(
+      std::basic_string<char_type, Traits, Allocator>& out,
+      const auto&... args
+  ) const
+    requires details::format_char<char_type>
+  {
+    details::formatting<Self>::append_to(out, args...);
+  }
+
+  // Returns the length of `format(args...)` without formatting the fragments
+  //
+  // `s.formatted_size(args...)` is same as
+  // `std::formatted_size(s.to_str(), args...)`.
+  [[nodiscard]] std::size_t formatted_size(const auto&... args) const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::formatted_size(args...);
+  }
+
+  // Returns an `edited_string` of the format string with the replacement
+  // fields of the first `sizeof...(Values)` arguments replaced with `Values`
+  // at compile time.
+  //
+  // [Note: `Values` are integers, `bool`, characters or string literals,
+  // which are written as `{}` does (so the fields must have no format spec).
+  // The other fields are kept (and renumbered if the argument indices are
+  // given), so that `s.bind<V1, V2>().format(args...)` is same as
+  // `s.format(V1, V2, args...)`. — end note]
+  //
+  // Example:
+  // ```cpp
+  //  constexpr auto query = R"(
+  //    SELECT {} FROM {} WHERE id = {}
+  //  )"_i.bind<"name, email", "users">();
+  //
+  //  static_assert(query == "SELECT name, email FROM users WHERE id = {}"sv);
+  //  auto str = query.format(user_id);
+  // ```
+  template <details::bound_value... Values>
+  [[nodiscard]] consteval auto bind() const
+    requires details::format_char<char_type>
+  {
+    return details::formatting<Self>::template bind<Values...>();
+  }
+
+  // Returns a lazy view of the edited string with `n` spaces inserted after
+  // each return (except before empty lines).
+  //
+  // [Note: No string is made; the lines are written to an output iterator
+  // with `copy_to(out)` (or to an output stream with `<<`). — end note]
+  //
+  // Example:
+  // ```cpp
+  //  constexpr auto body = R"(
+  //    if (x) {
+  //      return y;
+  //    }
+  //  )"_i;
+  //
+  //  out << "  void f() {\n    ";
+  //  body.reindent(4).copy_to(std::ostreambuf_iterator<char>(out));
+  //  out << "\n  }";
+  // ```
+  [[nodiscard]] constexpr details::reindent_view<Self>
+  reindent(std::size_t n) const noexcept {
+    return details::reindent_view<Self>{ n };
+  }
+
+  // Returns basic_string_view<char_type> of the edited string
+  //
+  // Example:
+  // ```cpp
+  //  constexpr std::string_view str = R"(
+  //    def foo():
+  //      print("Hello")
+  //      print("World")
+  //  )"_i.to_str();
+  //```
+  [[nodiscard]] constexpr std::basic_string_view<char_type> to_str() const {
+    return value();
+  }
+};
+
+namespace details
+{
+  template <class>
+  struct is_edited_strings : std::false_type
+  {};
+  template <auto S, auto _>
+  struct is_edited_strings<edited_string<S, _>> : std::true_type
+  {};
+
+  template <class T>
+  concept edited_strings = is_edited_strings<std::remove_cvref_t<T>>::value;
+} // namespace details
+
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline auto
+operator<=>(S1&&, S2&&) noexcept {
+  return std::remove_cvref_t<S1>::value() <=> std::remove_cvref_t<S2>::value();
+}
+
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline bool
+operator!=(S1&& lhs, S2&& rhs) noexcept {
+  return not(std::forward<S1>(lhs) == std::forward<S2>(rhs));
+}
+
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline bool
+operator==(S1&&, S2&&) noexcept {
+  using T1 = std::remove_cvref_t<S1>;
+  using T2 = std::remove_cvref_t<S2>;
+  // the lengths and the hashes are compared at compile time
+  if constexpr (std::same_as<T1, T2>) {
+    return true;
+  } else if constexpr (T1::size() != T2::size() or T1::hash() != T2::hash()) {
+    return false;
+  } else {
+    return T1::value() == T2::value();
+  }
+}
+
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline bool
+operator<(S1&&, S2&&) noexcept {
+  return std::remove_cvref_t<S1>::value() < std::remove_cvref_t<S2>::value();
+}
+
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline bool
+operator>(S1&&, S2&&) noexcept {
+  return std::remove_cvref_t<S1>::value() > std::remove_cvref_t<S2>::value();
+}
+
+// This is a transparent hasher of strings and edited strings
+// (FNV-1a, same as `edited_string::hash()`).
+//
+// [Note: Edited strings are not hashed at runtime, since the hash is
+// computed at compile time. So the keys of the lookups with edited strings
+// of an unordered container of strings are not hashed at runtime.
+// [Example:
+//   ```
+//   std::unordered_map<std::string, statement, string_hash, std::equal_to<>>
+//       cache;
+//   auto it = cache.find(R"(
+//     SELECT * FROM users WHERE id = ?
+//   )"_i);
+//   ```
+// — end example] — end note]
+struct string_hash
+{
+  using is_transparent = void;
+
+  template <typename CharT>
+  constexpr std::size_t
+  operator()(std::basic_string_view<CharT> str) const noexcept {
+    return details::fnv1a(str);
+  }
+
+  template <typename CharT, class Traits, class Allocator>
+  constexpr std::size_t
+  operator()(const std::basic_string<CharT, Traits, Allocator>& str
+  ) const noexcept {
+    return details::fnv1a(std::basic_string_view<CharT>(str));
+  }
+
+  template <typename CharT>
+  constexpr std::size_t operator()(const CharT* str) const noexcept {
+    return details::fnv1a(std::basic_string_view<CharT>(str));
+  }
+
+  template <details::edited_strings S>
+  constexpr std::size_t operator()(const S&) const noexcept {
+    return S::hash();
+  }
+};
+
+namespace details
+{
+  // the edited strings of `S...` joined in order
+  template <class First, class... Rest>
+  inline constexpr auto joined_literal = []() consteval {
+    using CharT = typename First::char_type;
+    constexpr std::size_t length = (First::size() + ... + Rest::size());
+    std::array<CharT, length + 1> buffer = {};
+    auto out = buffer.begin();
+    out = std::copy(First::value().begin(), First::value().end(), out);
+    ((out = std::copy(Rest::value().begin(), Rest::value().end(), out)), ...);
+    return basic_fixed_string<CharT, length>(buffer);
+  }();
+} // namespace details
+
+// `edited_string` of the edited strings `Strings...` joined at compile time
+//
+// [Note: The result depends only on the joined string, so that the same
+// joined string has one static storage however it is built. [Example:
+//   ```
+//   constexpr auto query = concat<select_clause, where_clause>;
+//   static_assert(std::same_as<
+//       decltype(concat<"a"_i, "bc"_i>), decltype(concat<"ab"_i, "c"_i>)>);
+//   ```
+// — end example] — end note]
+template <auto First, auto... Rest>
+  requires details::edited_strings<decltype(First)>
+           and (std::same_as<
+                    typename decltype(First)::char_type,
+                    typename decltype(Rest)::char_type>
+                and ...)
+inline constexpr auto concat = edited_string<
+    details::joined_literal<
+        std::remove_cvref_t<decltype(First)>,
+        std::remove_cvref_t<decltype(Rest)>...>,
+    details::as_is>{};
+
+// `s1 + s2` is same as `concat<s1, s2>`.
+//
+// [Note: Since `_i` removes leading and trailing returns and spaces,
+// separators are given with `verbatim`. [Example:
+//   ```
+//   constexpr auto query = select_clause + verbatim<"\n"> + where_clause;
+//   ```
+// — end example] — end note]
+template <details::edited_strings S1, details::edited_strings S2>
+  requires std::same_as<
+      typename std::remove_cvref_t<S1>::char_type,
+      typename std::remove_cvref_t<S2>::char_type>
+constexpr inline auto
+operator+(S1&&, S2&&) noexcept {
+  return concat<std::remove_cvref_t<S1>{}, std::remove_cvref_t<S2>{}>;
+}
+
+namespace details
+{
+  // the finalizer of SplitMix64
+  constexpr std::uint64_t
+  mix64(std::uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  // This is a perfect hash table of `N` strings (hash and displace).
+  //
+  // [Note: A string of hash `h` is in the bucket `bucket_of(h)`, and the
+  // strings in a bucket are in the slots `slot_of(h, seed)` with the seed of
+  // the bucket, which is searched at compile time so that no two strings
+  // are in the same slot. — end note]
+  template <std::size_t N>
+  struct match_table
+  {
+    static constexpr std::size_t slot_count = std::bit_ceil(N * 2);
+    static constexpr std::size_t bucket_count =
+        slot_count >= 4 ? slot_count / 4 : 1;
+
+    std::array<std::uint32_t, bucket_count> seeds = {};
+    // the index of the string in each slot (or `N` if empty)
+    std::array<std::uint32_t, slot_count> slots = {};
+
+    static constexpr std::size_t bucket_of(std::uint64_t hash) noexcept {
+      return static_cast<std::size_t>(mix64(hash) & (bucket_count - 1));
+    }
+
+    static constexpr std::size_t
+    slot_of(std::uint64_t hash, std::uint32_t seed) noexcept {
+      return static_cast<std::size_t>(
+          mix64(hash + (seed + std::uint64_t{ 1 }) * 0x9e3779b97f4a7c15)
+          & (slot_count - 1)
+      );
+    }
+  };
+
+  // the table of `strings` of `hashes`
+  template <typename CharT, std::size_t N>
+  consteval match_table<N>
+  make_match_table(
+      const std::array<std::basic_string_view<CharT>, N>& strings,
+      const std::array<std::uint64_t, N>& hashes
+  ) {
+    using table = match_table<N>;
+    match_table<N> result;
+    result.slots.fill(static_cast<std::uint32_t>(N));
+
+    std::array<std::size_t, N> bucket_of = {};
+    std::array<std::size_t, table::bucket_count> bucket_size = {};
+    for (std::size_t i = 0; i < N; ++i) {
+      for (std::size_t j = 0; j < i; ++j) {
+        // (the same strings have the same hashes)
+        if (strings[i] == strings[j])
+          throw "match: the strings must be distinct";
+        if (hashes[i] == hashes[j])
+          throw "match: the hashes of two strings collide";
+      }
+      bucket_of[i] = table::bucket_of(hashes[i]);
+      ++bucket_size[bucket_of[i]];
+    }
+
+    // place the largest buckets first
+    std::array<bool, table::bucket_count> placed = {};
+    for (std::size_t n = 0; n < table::bucket_count; ++n) {
+      std::size_t bucket = 0;
+      for (std::size_t b = 0; b < table::bucket_count; ++b) {
+        if (not placed[b]
+            and (placed[bucket] or bucket_size[b] > bucket_size[bucket]))
+          bucket = b;
+      }
+      placed[bucket] = true;
+      if (bucket_size[bucket] == 0)
+        continue;
+
+      for (std::uint32_t seed = 0;; ++seed) {
+        if (seed == (1u << 20))
+          throw "match: no seed found for a bucket";
+        std::array<std::size_t, N> slots = {};
+        std::size_t count = 0;
+        bool free = true;
+        for (std::size_t i = 0; i < N and free; ++i) {
+          if (bucket_of[i] != bucket)
+            continue;
+          const std::size_t slot = table::slot_of(hashes[i], seed);
+          free = result.slots[slot] == N;
+          for (std::size_t k = 0; k < count and free; ++k)
+            free = slots[k] != slot;
+          slots[count++] = slot;
+        }
+        if (not free)
+          continue;
+        count = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+          if (bucket_of[i] == bucket)
+            result.slots[slots[count++]] = static_cast<std::uint32_t>(i);
+        }
+        result.seeds[bucket] = seed;
+        break;
+      }
+    }
+    return result;
+  }
+
+  template <class... S>
+  struct matcher
+  {
+    using char_type =
+        typename std::tuple_element_t<0, std::tuple<S...>>::char_type;
+    static constexpr std::size_t size = sizeof...(S);
+
+    static constexpr std::array<std::basic_string_view<char_type>, size>
+        strings = { S::value()... };
+    static constexpr auto table = make_match_table<char_type, size>(
+        strings, { static_cast<std::uint64_t>(S::hash())... }
+    );
+
+    static constexpr bool distinct = [] {
+      for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+          if (strings[i] == strings[j])
+            return false;
+        }
+      }
+      return true;
+    }();
+
+    static constexpr std::size_t
+    find(std::basic_string_view<char_type> str) noexcept {
+      const auto hash = static_cast<std::uint64_t>(fnv1a(str));
+      const std::size_t index =
+          table.slots[table.slot_of(hash, table.seeds[table.bucket_of(hash)])];
+      return index < size and strings[index] == str ? index : size;
+    }
+  };
+} // namespace details
+
+// Returns the index of `str` in the edited strings `Strings...`,
+// or `sizeof...(Strings)` if `str` is none of them.
+//
+// [Note: A perfect hash table of `Strings...` is built at compile time, so
+// that `str` is hashed once and compared with at most one of them. The
+// strings must be distinct. [Example:
+//   ```
+//   switch (match<"GET"_i, "PUT"_i, "DELETE"_i>(method)) {
+//   case 0: return get(request);
+//   case 1: return put(request);
+//   case 2: return remove(request);
+//   default: return not_allowed(request);
+//   }
+//   ```
+// — end example] — end note]
+template <auto First, auto... Rest>
+  requires details::edited_strings<decltype(First)>
+           and (details::edited_strings<decltype(Rest)> and ...)
+           and (std::same_as<
+                    typename decltype(First)::char_type,
+                    typename decltype(Rest)::char_type>
+                and ...)
+constexpr std::size_t
+match(std::basic_string_view<typename decltype(First)::char_type> str
+) noexcept {
+  using matcher = details::matcher<
+      std::remove_cvref_t<decltype(First)>,
+      std::remove_cvref_t<decltype(Rest)>...>;
+  static_assert(matcher::distinct, "the strings of match must be distinct");
+  return matcher::find(str);
+}
+
+template <basic_fixed_string Lit>
+inline constexpr auto unindented =
+    edited_string<Lit, details::to_unindented>{}; // unindented string
+
+template <basic_fixed_string Lit>
+inline constexpr auto folded =
+    edited_string<Lit, details::to_folded>{}; // folded string
+
+template <basic_fixed_string Lit>
+inline constexpr auto verbatim =
+    edited_string<Lit, details::as_is>{}; // string kept as it is
+
+template <basic_fixed_string Lit, std::size_t K>
+inline constexpr auto indented = edited_string<
+    Lit, details::indenting<K>{}>{}; // unindented string indented by `K`
+
+template <basic_fixed_string Lit>
+inline constexpr auto minified_sql =
+    edited_string<Lit, details::to_minified_sql>{}; // minified SQL
+
+template <basic_fixed_string Lit>
+inline constexpr auto minified_json =
+    edited_string<Lit, details::to_minified_json>{}; // minified JSON
+
+} // namespace mitama::unindent
+
+namespace mitama::unindent::inline literals
+{
+// indent-adjusted multiline string literal
+// This literal operator returns an indent-adjusted string.
+//
+// Example:
+// ```cpp
+//  constexpr std::string_view unindented_str = R"(
+//    def foo():
+//      print("Hello")
+//      print("World")
+//  )"_iv;
+//
+//  std::cout << unindented_str;
+//  // Output:
+//  // def foo():
+//  //   print("Hello")
+//  //   print("World")
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_iv() {
+  return unindented<S>.to_str();
+}
+
+// indent-adjusted multiline string literal
+// This literal operator returns an indent-adjusted string.
+//
+// Example:
+// ```cpp
+//  constexpr auto unindented_str = R"(
+//    def foo():
+//      print("Hello")
+//      print("World")
+//  )"_i;
+//
+//  std::cout << unindented_str;
+//  // Output:
+//  // def foo():
+//  //   print("Hello")
+//  //   print("World")
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_i() {
+  return unindented<S>;
+}
+
+// folded multiline string literal
+// This literal operator returns a folded string.
+//
+// Example:
+// ```cpp
+//  constexpr std::string_view folded_str = R"(
+//    cmake
+//    -DCMAKE_BUILD_TYPE=Release
+//    -B build
+//    -S .
+//  )"_i1v;
+//
+//  std::cout << folded_str;
+//  // Output:
+//  // cmake -DCMAKE_BUILD_TYPE=Release -B build -S .
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_i1v() {
+  return folded<S>.to_str();
+}
+
+// folded multiline string literal
+// This literal operator returns a folded string.
+//
+// Example:
+// ```cpp
+//  constexpr auto folded_str = R"(
+//    cmake
+//    -DCMAKE_BUILD_TYPE=Release
+//    -B build
+//    -S .
+//  )"_i1;
+//
+//  std::cout << folded_str;
+//  // Output:
+//  // cmake -DCMAKE_BUILD_TYPE=Release -B build -S .
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_i1() {
+  return folded<S>;
+}
+
+// minified SQL string literal
+// This literal operator returns a SQL string with whitespace and comments
+// outside of quotes minimized (see `details::sql_minifying`).
+//
+// Example:
+// ```cpp
+//  constexpr auto query = R"(
+//    SELECT id, name -- the columns
+//    FROM users
+//    WHERE name = 'John  Doe'
+//  )"_isql;
+//
+//  std::cout << query;
+//  // Output:
+//  // SELECT id,name FROM users WHERE name = 'John  Doe'
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_isql() {
+  return minified_sql<S>;
+}
+
+// minified JSON string literal
+// This literal operator returns a JSON string without whitespace outside of
+// strings.
+//
+// Example:
+// ```cpp
+//  constexpr auto body = R"(
+//    {
+//      "name": "John  Doe",
+//      "tags": [1, 2]
+//    }
+//  )"_ijson;
+//
+//  std::cout << body;
+//  // Output:
+//  // {"name":"John  Doe","tags":[1,2]}
+// ```
+template <basic_fixed_string S>
+inline consteval auto
+operator""_ijson() {
+  return minified_json<S>;
+}
+} // namespace mitama::unindent::inline literals
+
+template <mitama::unindent::basic_fixed_string Lit, auto Editor>
+struct std::hash<mitama::unindent::edited_string<Lit, Editor>>
+{
+  constexpr std::size_t
+  operator()(const mitama::unindent::edited_string<Lit, Editor>&)
+      const noexcept {
+    return mitama::unindent::edited_string<Lit, Editor>::hash();
+  }
+};
@@ -0,0 +1,647 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unindent/core.hpp>
+#include <utility>
+
+// This header provides the format members of `edited_string` (`format`,
+// `format_to`, `format_to_n`, `append_to`, `formatted_size` and `bind`),
+// and `std::formatter` of the edited strings and `basic_fixed_string`.
+//
+// [Note: The members are declared by <unindent/core.hpp>, so that the
+// headers not using them don't include <format>; calling them without this
+// header is ill-formed (`details::formatting` is incomplete). — end note]
+namespace mitama::unindent
+{
+namespace details
+{
+  // a piece of a format string parsed at compile time
+  struct format_piece
+  {
+    bool field = false; // a replacement field (or a literal fragment)
+    // a fragment: the range of the fragment in the format string
+    // a field: the range of the format of the field (e.g. `{:>8}`)
+    // in `format_plan::specs`
+    std::size_t offset = 0;
+    std::size_t length = 0;
+    std::size_t arg = 0; // the index of the argument of a field
+    bool plain = false;  // a field without format spec (i.e. `{}`)
+  };
+
+  // parses `str` as a format string of `std::format` and invokes
+  // `on_fragment(offset, length)` for each literal fragment (escaped braces
+  // unescaped) and `on_field(arg, spec, manual)` for each replacement field
+  // (`manual` if the argument index is given).
+  // Returns `false` if `str` is invalid or has nested replacement fields
+  // (e.g. `{:{}}`), which are left to `std::format`.
+  template <typename CharT, class OnFragment, class OnField>
+  constexpr bool parse_format(
+      std::basic_string_view<CharT> str, OnFragment on_fragment,
+      OnField on_field
+  ) {
+    enum class indexing { unknown, automatic, manual };
+    indexing mode = indexing::unknown;
+    std::size_t next_arg = 0;
+    std::size_t first = 0; // the first character of the current fragment
+    std::size_t pos = 0;
+    const std::size_t size = str.size();
+    const auto is_digit = [&](std::size_t i) {
+      return i < size and CharT('0') <= str[i] and str[i] <= CharT('9');
+    };
+
+    while (pos < size) {
+      const CharT c = str[pos];
+      if (c != CharT('{') and c != CharT('}')) {
+        ++pos;
+        continue;
+      }
+      if (pos + 1 < size and str[pos + 1] == c) {
+        // `{{` or `}}`: the fragment ends with the first brace
+        on_fragment(first, pos + 1 - first);
+        first = pos += 2;
+        continue;
+      }
+      if (c == CharT('}'))
+        return false; // unmatched `}`
+      if (pos > first)
+        on_fragment(first, pos - first);
+      ++pos;
+
+      std::size_t arg = 0;
+      if (is_digit(pos)) {
+        if (mode == indexing::automatic)
+          return false;
+        mode = indexing::manual;
+        if (str[pos] == CharT('0')) {
+          ++pos; // no leading zeros
+        } else {
+          while (is_digit(pos))
+            arg = arg * 10 + static_cast<std::size_t>(str[pos++] - CharT('0'));
+        }
+      } else {
+        if (mode == indexing::manual)
+          return false;
+        mode = indexing::automatic;
+        arg = next_arg++;
+      }
+
+      std::size_t spec_first = pos;
+      if (pos < size and str[pos] == CharT(':')) {
+        spec_first = ++pos;
+        while (pos < size and str[pos] != CharT('{') and str[pos] != CharT('}'))
+          ++pos;
+      }
+      if (pos == size or str[pos] != CharT('}'))
+        return false; // unterminated or nested replacement field
+      on_field(
+          arg, str.substr(spec_first, pos - spec_first),
+          mode == indexing::manual
+      );
+      first = ++pos;
+    }
+    if (first < size)
+      on_fragment(first, size - first);
+    return true;
+  }
+
+  // the format string parsed at compile time
+  template <typename CharT, std::size_t Pieces, std::size_t Specs>
+  struct format_plan
+  {
+    bool compiled = false; // otherwise `std::format` parses it at runtime
+    std::size_t args = 0;  // the number of arguments used
+    bool manual = false;   // the argument indices are given (e.g. `{0}`)
+    std::array<format_piece, Pieces> pieces = {};
+    // the formats of the fields without the argument indices
+    std::array<CharT, Specs> specs = {};
+  };
+
+  // phase 1: the extents of the plan of `str`
+  template <typename CharT>
+  consteval auto
+  format_extents(std::basic_string_view<CharT> str) {
+    struct
+    {
+      bool compiled;
+      std::size_t pieces = 0;
+      std::size_t specs = 0;
+    } result;
+    result.compiled = parse_format(
+        str, [&](std::size_t, std::size_t) { ++result.pieces; },
+        [&](std::size_t, std::basic_string_view<CharT> spec, bool) {
+          ++result.pieces;
+          result.specs += spec.empty() ? 2 : spec.size() + 3; // `{:` `}`
+        }
+    );
+    return result;
+  }
+
+  // phase 2: the plan of `str`
+  template <typename CharT, std::size_t Pieces, std::size_t Specs>
+  consteval auto
+  make_format_plan(std::basic_string_view<CharT> str) {
+    format_plan<CharT, Pieces, Specs> plan;
+    std::size_t piece = 0;
+    std::size_t spec_size = 0;
+    plan.compiled = parse_format(
+        str,
+        [&](std::size_t offset, std::size_t length) {
+          plan.pieces[piece++] = { false, offset, length };
+        },
+        [&](std::size_t arg, std::basic_string_view<CharT> spec, bool manual) {
+          plan.manual = manual;
+          const std::size_t offset = spec_size;
+          plan.specs[spec_size++] = CharT('{');
+          if (not spec.empty()) {
+            plan.specs[spec_size++] = CharT(':');
+            for (const CharT c : spec)
+              plan.specs[spec_size++] = c;
+          }
+          plan.specs[spec_size++] = CharT('}');
+          plan.pieces[piece++] =
+              { true, offset, spec_size - offset, arg, spec.empty() };
+          plan.args = std::max(plan.args, arg + 1);
+        }
+    );
+    return plan;
+  }
+
+  // the format string `S::value()` parsed at compile time
+  template <class S>
+  inline constexpr auto format_plan_of = [] {
+    constexpr auto extents = format_extents(S::value());
+    if constexpr (extents.compiled) {
+      return make_format_plan<
+          typename S::char_type, extents.pieces, extents.specs>(S::value());
+    } else {
+      return format_plan<typename S::char_type, 0, 0>{};
+    }
+  }();
+
+  // the formats of the fields of `S::value()` (kept apart from the pieces,
+  // since only the formats are referenced at runtime)
+  template <class S>
+  inline constexpr auto format_specs_of = format_plan_of<S>.specs;
+
+  // string arguments written as they are by `{}`
+  template <class T, typename CharT>
+  concept plain_string = std::same_as<T, const CharT*>
+      or std::same_as<T, CharT*>
+      or std::same_as<T, std::basic_string_view<CharT>>
+      or std::same_as<T, std::basic_string<CharT>>;
+
+  // integer arguments written with `std::to_chars` by `{}`
+  template <class T, typename CharT>
+  concept plain_integer = std::same_as<CharT, char> and std::integral<T>
+      and not std::same_as<T, bool> and not std::same_as<T, char>
+      and not std::same_as<T, wchar_t> and not std::same_as<T, char8_t>
+      and not std::same_as<T, char16_t> and not std::same_as<T, char32_t>;
+
+  template <class S, std::size_t I, class Arg>
+  inline constexpr auto field_format = [] {
+    constexpr format_piece piece = format_plan_of<S>.pieces[I];
+    return std::basic_format_string<typename S::char_type, const Arg&>(
+        std::basic_string_view<typename S::char_type>(
+            format_specs_of<S>.data() + piece.offset, piece.length
+        )
+    );
+  }();
+
+  // writer of the formatted string appending to a string
+  template <typename CharT, class String = std::basic_string<CharT>>
+  struct string_writer
+  {
+    String& out;
+
+    void write(const CharT* str, std::size_t length) {
+      out.append(str, length);
+    }
+
+    template <class Arg>
+    void
+    write(std::basic_format_string<CharT, const Arg&> fmt, const Arg& arg) {
+      std::format_to(std::back_inserter(out), fmt, arg);
+    }
+  };
+
+  // writer of the formatted string to an output iterator
+  template <typename CharT, class OutputIt>
+  struct iterator_writer
+  {
+    OutputIt out;
+
+    void write(const CharT* str, std::size_t length) {
+      out = std::ranges::copy(str, str + length, std::move(out)).out;
+    }
+
+    template <class Arg>
+    void
+    write(std::basic_format_string<CharT, const Arg&> fmt, const Arg& arg) {
+      out = std::format_to(std::move(out), fmt, arg);
+    }
+  };
+
+  // writer of the formatted string counting the characters
+  template <typename CharT>
+  struct size_writer
+  {
+    std::size_t size = 0;
+
+    void write(const CharT*, std::size_t length) noexcept {
+      size += length;
+    }
+
+    template <class Arg>
+    void
+    write(std::basic_format_string<CharT, const Arg&> fmt, const Arg& arg) {
+      size += std::formatted_size(fmt, arg);
+    }
+  };
+
+  // writer of at most `limit` characters of the formatted string
+  // to an output iterator (counting all the characters)
+  template <typename CharT, class OutputIt>
+  struct bounded_writer
+  {
+    OutputIt out;
+    std::size_t limit;
+    std::size_t size = 0;
+
+    void write(const CharT* str, std::size_t length) {
+      const std::size_t n = std::min(length, rest());
+      out = std::ranges::copy(str, str + n, std::move(out)).out;
+      size += length;
+    }
+
+    template <class Arg>
+    void
+    write(std::basic_format_string<CharT, const Arg&> fmt, const Arg& arg) {
+      auto result = std::format_to_n(std::move(out), rest(), fmt, arg);
+      out = std::move(result.out);
+      size += static_cast<std::size_t>(result.size);
+    }
+
+    std::size_t rest() const noexcept {
+      return size < limit ? limit - size : 0;
+    }
+  };
+
+  // writes the `I`-th piece of `S::value()` formatted with `args` to `writer`
+  template <class S, std::size_t I, class Writer, class Args>
+  void
+  write_piece(Writer& writer, const Args& args) {
+    using CharT = typename S::char_type;
+    constexpr format_piece piece = format_plan_of<S>.pieces[I];
+    if constexpr (not piece.field) {
+      writer.write(S::data() + piece.offset, piece.length);
+    } else {
+      const auto& arg = std::get<piece.arg>(args);
+      using Arg = std::remove_cvref_t<decltype(arg)>;
+      if constexpr (piece.plain and plain_string<std::decay_t<Arg>, CharT>) {
+        const std::basic_string_view<CharT> str(arg);
+        writer.write(str.data(), str.size());
+      } else if constexpr (piece.plain and plain_integer<Arg, CharT>) {
+        char buf[std::numeric_limits<Arg>::digits10 + 2];
+        const auto result = std::to_chars(std::begin(buf), std::end(buf), arg);
+        writer.write(buf, static_cast<std::size_t>(result.ptr - buf));
+      } else {
+        writer.write(field_format<S, I, Arg>, arg);
+      }
+    }
+  }
+
+  // writes `S::value()` formatted with `args` to `writer`
+  template <class S, class Writer, class... Args>
+  void
+  write_formatted(Writer& writer, const Args&... args) {
+    constexpr auto& plan = format_plan_of<S>;
+    const auto tied = std::tie(args...);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (write_piece<S, I>(writer, tied), ...);
+    }(std::make_index_sequence<plan.pieces.size()>{});
+  }
+
+  template <class>
+  struct is_fixed_string : std::false_type
+  {};
+  template <class CharT, std::size_t N>
+  struct is_fixed_string<basic_fixed_string<CharT, N>> : std::true_type
+  {};
+
+  // values written by `{}` at compile time
+  template <class T, typename CharT>
+  concept bindable = std::same_as<T, bool> or std::same_as<T, CharT>
+      or (is_fixed_string<T>::value
+          and std::same_as<typename T::char_type, CharT>)
+      or (std::integral<T> and not std::same_as<T, char>
+          and not std::same_as<T, wchar_t> and not std::same_as<T, char8_t>
+          and not std::same_as<T, char16_t> and not std::same_as<T, char32_t>);
+
+  // writes `value` as `{}` does to `emit` (braces are escaped)
+  template <typename CharT, class T, class Emit>
+  constexpr void
+  emit_bound(const T& value, Emit& emit) {
+    const auto escaped = [&](CharT c) {
+      emit(c);
+      if (c == CharT('{') or c == CharT('}'))
+        emit(c);
+    };
+    if constexpr (is_fixed_string<T>::value) {
+      for (const CharT c : value.to_str())
+        escaped(c);
+    } else if constexpr (std::same_as<T, bool>) {
+      for (const char* p = value ? "true" : "false"; *p != '\0'; ++p)
+        emit(CharT(*p));
+    } else if constexpr (std::same_as<T, CharT>) {
+      escaped(value);
+    } else {
+      using U = std::make_unsigned_t<T>;
+      U n = static_cast<U>(value);
+      bool negative = false;
+      if constexpr (std::is_signed_v<T>) {
+        negative = value < 0;
+        if (negative)
+          n = static_cast<U>(U{ 0 } - n);
+      }
+      CharT digits[std::numeric_limits<U>::digits10 + 1] = {};
+      std::size_t length = 0;
+      do {
+        digits[length++] = static_cast<CharT>(CharT('0') + n % 10);
+        n /= 10;
+      } while (n != 0);
+      if (negative)
+        emit(CharT('-'));
+      while (length > 0)
+        emit(digits[--length]);
+    }
+  }
+
+  // writes the format string `S::value()` with the fields of the first
+  // arguments replaced with `Values...` to `emit` (the other fields are
+  // renumbered if the argument indices are given)
+  template <class S, auto... Values, class Emit>
+  constexpr void
+  emit_bound_format(Emit emit) {
+    using CharT = typename S::char_type;
+    constexpr auto& plan = format_plan_of<S>;
+    constexpr std::size_t bound = sizeof...(Values);
+    const auto str = S::value();
+
+    for (const format_piece& piece : plan.pieces) {
+      if (not piece.field) {
+        for (const CharT c : str.substr(piece.offset, piece.length)) {
+          emit(c);
+          if (c == CharT('{') or c == CharT('}'))
+            emit(c); // escape again
+        }
+      } else if (piece.arg < bound) {
+        std::size_t i = 0;
+        ((i++ == piece.arg ? emit_bound<CharT>(Values.value, emit) : void()),
+         ...);
+      } else {
+        // `{}` or `{:spec}`
+        const auto format = std::basic_string_view<CharT>(
+            plan.specs.data() + piece.offset, piece.length
+        );
+        emit(format[0]);
+        if (plan.manual)
+          emit_bound<CharT>(piece.arg - bound, emit);
+        for (const CharT c : format.substr(1))
+          emit(c);
+      }
+    }
+  }
+
+  // all the fields bound to `Bound` arguments are `{}`
+  template <class S, std::size_t Bound>
+  inline constexpr bool plain_bound_fields = [] {
+    for (const format_piece& piece : format_plan_of<S>.pieces) {
+      if (piece.field and piece.arg < Bound and not piece.plain)
+        return false;
+    }
+    return true;
+  }();
+
+  template <class S, auto... Values>
+  inline constexpr std::size_t bound_length = [] {
+    std::size_t length = 0;
+    emit_bound_format<S, Values...>([&](auto) { ++length; });
+    return length;
+  }();
+
+  // the format string `S::value()` with `Values...` bound
+  template <class S, auto... Values>
+  inline constexpr auto bound_literal = []() consteval {
+    using CharT = typename S::char_type;
+    constexpr std::size_t length = bound_length<S, Values...>;
+    std::array<CharT, length + 1> buffer = {};
+    std::size_t index = 0;
+    emit_bound_format<S, Values...>([&](CharT c) { buffer[index++] = c; });
+    return basic_fixed_string<CharT, length>(buffer);
+  }();
+
+  template <class S>
+  struct formatting
+  {
+    using char_type = typename S::char_type;
+    static constexpr auto& plan = format_plan_of<S>;
+
+    static auto format(auto&&... args) {
+      if constexpr (not plan.compiled) {
+        return std::format(S::value(), std::forward<decltype(args)>(args)...);
+      } else {
+        static_assert(
+            sizeof...(args) >= plan.args,
+            "too few arguments for the replacement fields of the format string"
+        );
+        std::basic_string<char_type> result;
+        result.reserve(formatted_size(args...));
+        string_writer<char_type> writer{ result };
+        write_formatted<S>(writer, args...);
+        return result;
+      }
+    }
+
+    template <class Allocator>
+    static auto format_allocated(const Allocator& alloc, const auto&... args) {
+      allocated_string<char_type, Allocator> result(alloc);
+      if constexpr (plan.compiled)
+        result.reserve(formatted_size(args...));
+      append_to(result, args...);
+      return result;
+    }
+
+    template <class OutputIt>
+    static OutputIt format_to(OutputIt out, const auto&... args) {
+      if constexpr (not plan.compiled) {
+        return std::format_to(std::move(out), S::value(), args...);
+      } else {
+        static_assert(
+            sizeof...(args) >= plan.args,
+            "too few arguments for the replacement fields of the format string"
+        );
+        iterator_writer<char_type, OutputIt> writer{ std::move(out) };
+        write_formatted<S>(writer, args...);
+        return std::move(writer.out);
+      }
+    }
+
+    template <class OutputIt>
+    static std::format_to_n_result<OutputIt> format_to_n(
+        OutputIt out, std::iter_difference_t<OutputIt> n, const auto&... args
+    ) {
+      if constexpr (not plan.compiled) {
+        return std::format_to_n(std::move(out), n, S::value(), args...);
+      } else {
+        static_assert(
+            sizeof...(args) >= plan.args,
+            "too few arguments for the replacement fields of the format string"
+        );
+        bounded_writer<char_type, OutputIt> writer{
+          std::move(out), n > 0 ? static_cast<std::size_t>(n) : 0
+        };
+        write_formatted<S>(writer, args...);
+        return { std::move(writer.out),
+                 static_cast<std::iter_difference_t<OutputIt>>(writer.size) };
+      }
+    }
+
+    template <class Traits, class Allocator>
+    static void append_to(
+        std::basic_string<char_type, Traits, Allocator>& out,
+        const auto&... args
+    ) {
+      if constexpr (not plan.compiled) {
+        std::format_to(std::back_inserter(out), S::value(), args...);
+      } else {
+        static_assert(
+            sizeof...(args) >= plan.args,
+            "too few arguments for the replacement fields of the format string"
+        );
+        string_writer<char_type, std::remove_cvref_t<decltype(out)>> writer{
+          out
+        };
+        write_formatted<S>(writer, args...);
+      }
+    }
+
+    static std::size_t formatted_size(const auto&... args) {
+      if constexpr (not plan.compiled) {
+        return std::formatted_size(S::value(), args...);
+      } else {
+        static_assert(
+            sizeof...(args) >= plan.args,
+            "too few arguments for the replacement fields of the format string"
+        );
+        size_writer<char_type> writer;
+        write_formatted<S>(writer, args...);
+        return writer.size;
+      }
+    }
+
+    template <auto... Values>
+    static consteval auto bind() {
+      static_assert(
+          plan.compiled,
+          "bind() requires a valid format string without nested replacement "
+          "fields"
+      );
+      static_assert(
+          sizeof...(Values) <= plan.args,
+          "too many values for the replacement fields of the format string"
+      );
+      static_assert(
+          (bindable<
+               typename std::remove_cvref_t<decltype(Values)>::type, char_type>
+           and ...),
+          "bind() accepts integers, bool, characters and string literals"
+      );
+      static_assert(
+          plain_bound_fields<S, sizeof...(Values)>,
+          "the replacement fields of bound values must be `{}`"
+      );
+      return edited_string<bound_literal<S, Values...>, as_is>{};
+    }
+  };
+
+  // This is the base of the `std::formatter`s of the strings of this library,
+  // formatting the string as `std::basic_string_view<CharT>` is formatted
+  // (with the fill, the alignment, the width and the precision).
+  //
+  // [Note: Without format spec (i.e. `{}`), the string is copied to the
+  // output as it is, without the padding and the truncation. — end note]
+  template <typename CharT>
+  struct string_formatter : std::formatter<std::basic_string_view<CharT>, CharT>
+  {
+    using base = std::formatter<std::basic_string_view<CharT>, CharT>;
+
+    constexpr auto parse(std::basic_format_parse_context<CharT>& ctx) {
+      plain_ = ctx.begin() == ctx.end() or *ctx.begin() == CharT('}');
+      return base::parse(ctx);
+    }
+
+    template <class FormatContext>
+    auto write(std::basic_string_view<CharT> str, FormatContext& ctx) const {
+      if (plain_)
+        return std::ranges::copy(str, ctx.out()).out;
+      return base::format(str, ctx);
+    }
+
+  private:
+    bool plain_ = false;
+  };
+} // namespace details
+} // namespace mitama::unindent
+
+// `std::formatter` of the edited strings and `basic_fixed_string`, which
+// writes the string to the output without converting it.
+//
+// [Example:
+//   ```
+//   constexpr auto query = R"(
+//     SELECT * FROM users
+//   )"_i;
+//
+//   auto str = std::format("query: {}", query); // "query: SELECT * FROM users"
+//   auto padded = std::format("[{:>8.3}]", query); // "[     SEL]"
+//   ```
+// — end example]
+template <mitama::unindent::basic_fixed_string Lit, auto Editor, typename CharT>
+  requires std::same_as<
+      CharT, typename mitama::unindent::edited_string<Lit, Editor>::char_type>
+struct std::formatter<mitama::unindent::edited_string<Lit, Editor>, CharT>
+    : mitama::unindent::details::string_formatter<CharT>
+{
+  template <class FormatContext>
+  auto format(
+      const mitama::unindent::edited_string<Lit, Editor>& str,
+      FormatContext& ctx
+  ) const {
+    return this->write(str.value(), ctx);
+  }
+};
+
+template <typename CharT, std::size_t N>
+struct std::formatter<mitama::unindent::basic_fixed_string<CharT, N>, CharT>
+    : mitama::unindent::details::string_formatter<CharT>
+{
+  template <class FormatContext>
+  auto format(
+      const mitama::unindent::basic_fixed_string<CharT, N>& str,
+      FormatContext& ctx
+  ) const {
+    return this->write(std::basic_string_view<CharT>(str.data.data(), N), ctx);
+  }
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <iterator>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <unindent/core.hpp>
+
+// This header provides the stream output operators of `basic_fixed_string`,
+// the edited strings and `reindent(n)`.
+namespace mitama::unindent
+{
+template <class CharT, class Traits, std::size_t N>
+inline std::basic_ostream<CharT, Traits>&
+operator<<(
+    std::basic_ostream<CharT, Traits>& os,
+    const basic_fixed_string<CharT, N>& fs
+) {
+  return os << std::basic_string_view<CharT, Traits>(fs.data.data(), N);
+}
+
+template <details::edited_strings S>
+inline std::basic_ostream<typename std::remove_cvref_t<S>::char_type>&
+operator<<(
+    std::basic_ostream<typename std::remove_cvref_t<S>::char_type>& os, S&&
+) {
+  return os << std::remove_cvref_t<S>::value();
+}
+
+namespace details
+{
+  template <class S>
+  inline std::basic_ostream<typename S::char_type>&
+  operator<<(
+      std::basic_ostream<typename S::char_type>& os,
+      const reindent_view<S>& view
+  ) {
+    view.copy_to(std::ostreambuf_iterator<typename S::char_type>(os));
+    return os;
+  }
+} // namespace details
+} // namespace mitama::unindent
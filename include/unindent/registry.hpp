@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// the attributes of the descriptors put into the registry section
+#if defined(_MSC_VER) && !defined(__clang__)
+#  pragma section("unindreg", read)
+#  define UNINDENT_REGISTRY_SECTION __declspec(allocate("unindreg"))
+#elif defined(__APPLE__)
+#  define UNINDENT_REGISTRY_SECTION                                           \
+    __attribute__((used, section("__DATA,__unindent_reg")))
+#elif __has_attribute(retain)
+// (kept by `--gc-sections`)
+#  define UNINDENT_REGISTRY_SECTION                                           \
+    __attribute__((used, retain, section("unindent_registry")))
+#else
+#  define UNINDENT_REGISTRY_SECTION                                           \
+    __attribute__((used, section("unindent_registry")))
+#endif
+
+namespace mitama::unindent
+{
+// the editors of `registry_entry`
+enum class editor_kind : std::uint8_t {
+  custom,        // an editor not of the library
+  unindent,      // `_i` and `unindented`
+  fold,          // `_i1` and `folded`
+  verbatim,      // `verbatim`
+  indent,        // `indented`
+  minified_sql,  // `_isql` and `minified_sql`
+  minified_json, // `_ijson` and `minified_json`
+  composed,      // `compose`
+};
+
+// the name of `kind` (e.g. "unindent")
+constexpr std::string_view
+name_of(editor_kind kind) noexcept {
+  constexpr std::string_view names[] = {
+    "custom", "unindent",     "fold",          "verbatim",
+    "indent", "minified_sql", "minified_json", "composed",
+  };
+  const auto i = static_cast<std::size_t>(kind);
+  return i < std::size(names) ? names[i] : "unknown";
+}
+
+// This is the descriptor of an edited string, which is put into the binary
+// for each `edited_string` if `UNINDENT_ENABLE_REGISTRY` is defined.
+//
+// [Note: The descriptors are constants (with no code run at startup), put
+// into the section `unindent_registry` (`__DATA,__unindent_reg` on Mach-O
+// and `unindreg` on Windows) where the compiler supports sections on
+// templates. They are found by `scan_registry` in any case, since they begin
+// with `registry_entry::magic` and are aligned to 8 bytes. — end note]
+struct alignas(8) registry_entry
+{
+  static constexpr char magic[8] = { 'U', 'N', 'I', 'N', 'D', 'R', 'E', 'G' };
+  static constexpr std::uint16_t current_version = 1;
+
+  char tag[8];
+  std::uint16_t version;
+  editor_kind editor;
+  std::uint8_t char_size; // `sizeof(char_type)`
+  std::uint32_t preview_size;
+  std::uint64_t raw_size;    // the length of the literal
+  std::uint64_t edited_size; // `size()`
+  std::uint64_t hash;        // `hash()`
+  // the first line of the edited string (at most 32 bytes, where the
+  // characters not in ASCII of wide strings are '?')
+  char preview[32];
+
+  [[nodiscard]] constexpr std::string_view preview_view() const noexcept {
+    return { preview, preview_size };
+  }
+};
+
+// a descriptor of the edited strings of `CharT` in `text`
+template <typename CharT>
+constexpr registry_entry
+make_registry_entry(
+    editor_kind editor, std::size_t raw_size,
+    std::basic_string_view<CharT> text, std::size_t hash
+) noexcept {
+  registry_entry entry = {};
+  std::copy(
+      std::begin(registry_entry::magic), std::end(registry_entry::magic),
+      entry.tag
+  );
+  entry.version = registry_entry::current_version;
+  entry.editor = editor;
+  entry.char_size = sizeof(CharT);
+  entry.raw_size = raw_size;
+  entry.edited_size = text.size();
+  entry.hash = hash;
+  std::uint32_t size = 0;
+  for (; size < sizeof(entry.preview) and size < text.size(); ++size) {
+    const auto c = static_cast<std::uint32_t>(text[size]);
+    if (c == '\n')
+      break;
+    entry.preview[size] =
+        sizeof(CharT) == 1 or c < 0x80 ? static_cast<char>(text[size]) : '?';
+  }
+  entry.preview_size = size;
+  return entry;
+}
+
+// Returns the descriptors found in `image`, the contents of a binary
+// (e.g. an executable or a shared library mapped in memory).
+//
+// [Note: The descriptors are read in the byte order of the host. A match
+// of `magic` is taken only if the rest of the descriptor is valid, so that
+// other data beginning with it is skipped. — end note]
+inline std::vector<registry_entry>
+scan_registry(std::span<const char> image) {
+  std::vector<registry_entry> entries;
+  const std::string_view magic(registry_entry::magic, 8);
+  const std::string_view bytes(image.data(), image.size());
+  for (std::size_t pos = bytes.find(magic); pos != std::string_view::npos;
+       pos = bytes.find(magic, pos + 1)) {
+    // (aligned in the file, since sections are aligned at least to 8 bytes)
+    if (pos % alignof(registry_entry) != 0
+        or bytes.size() - pos < sizeof(registry_entry))
+      continue;
+    registry_entry entry;
+    std::memcpy(&entry, bytes.data() + pos, sizeof(entry));
+    if (entry.version != registry_entry::current_version
+        or name_of(entry.editor) == "unknown"
+        or (entry.char_size != 1 and entry.char_size != 2
+            and entry.char_size != 4)
+        or entry.preview_size > sizeof(entry.preview)
+        or entry.preview_size > entry.edited_size)
+      continue;
+    entries.push_back(entry);
+    pos += sizeof(registry_entry) - 1;
+  }
+  return entries;
+}
+} // namespace mitama::unindent
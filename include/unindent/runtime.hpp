@@ -0,0 +1,301 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unindent/core.hpp>
+
+// SIMD implementation of the scanning of runtime editors
+// (define `UNINDENT_NO_SIMD` to use the scalar implementation)
+#if !defined(UNINDENT_NO_SIMD)
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define UNINDENT_SIMD_AVX2
+#    define UNINDENT_SIMD_SSE2
+#  elif defined(__SSE2__) || defined(_M_X64) \
+      || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define UNINDENT_SIMD_SSE2
+#  elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define UNINDENT_SIMD_NEON
+#  endif
+#endif
+
+namespace mitama::unindent::details::simd
+{
+// the index of the first character of [first, last) that is `c`
+// (if `Equal`) or is not `c` (if `!Equal`), or `last - first`
+template <bool Equal>
+inline std::size_t
+find_first(const char* first, const char* last, char c) noexcept {
+  const char* p = first;
+#if defined(UNINDENT_SIMD_AVX2)
+  const __m256i needle32 = _mm256_set1_epi8(c);
+  for (; last - p >= 32; p += 32) {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle32))
+    );
+    if constexpr (!Equal)
+      mask = ~mask;
+    if (mask != 0)
+      return static_cast<std::size_t>(p - first) + std::countr_zero(mask);
+  }
+#endif
+#if defined(UNINDENT_SIMD_SSE2)
+  const __m128i needle16 = _mm_set1_epi8(c);
+  for (; last - p >= 16; p += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle16))
+    );
+    if constexpr (!Equal)
+      mask = ~mask & 0xFFFF;
+    if (mask != 0)
+      return static_cast<std::size_t>(p - first) + std::countr_zero(mask);
+  }
+#elif defined(UNINDENT_SIMD_NEON)
+  const uint8x16_t needle16 = vdupq_n_u8(static_cast<std::uint8_t>(c));
+  for (; last - p >= 16; p += 16) {
+    uint8x16_t eq =
+        vceqq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(p)), needle16);
+    if constexpr (!Equal)
+      eq = vmvnq_u8(eq);
+    // 4 bits per byte
+    const std::uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0
+    );
+    if (mask != 0)
+      return static_cast<std::size_t>(p - first) + std::countr_zero(mask) / 4;
+  }
+#endif
+  for (; p != last; ++p) {
+    if ((*p == c) == Equal)
+      break;
+  }
+  return static_cast<std::size_t>(p - first);
+}
+} // namespace mitama::unindent::details::simd
+
+namespace mitama::unindent
+{
+namespace details
+{
+  // character scanning of the runtime editors
+  // (SIMD for `char`, `scalar_scanner` otherwise)
+  struct simd_scanner
+  {
+    template <typename CharT>
+    static std::size_t
+    find_return(std::basic_string_view<CharT> str, std::size_t pos) noexcept {
+      if constexpr (std::same_as<CharT, char>) {
+        return pos + simd::find_first<true>(
+                         str.data() + pos, str.data() + str.size(), '\n'
+                     );
+      } else {
+        return scalar_scanner::find_return(str, pos);
+      }
+    }
+
+    template <typename CharT>
+    static std::size_t count_spaces(
+        std::basic_string_view<CharT> str, std::size_t pos, std::size_t limit
+    ) noexcept {
+      if constexpr (std::same_as<CharT, char>) {
+        limit = std::min(limit, str.size() - pos);
+        return simd::find_first<false>(
+            str.data() + pos, str.data() + pos + limit, ' '
+        );
+      } else {
+        return scalar_scanner::count_spaces(str, pos, limit);
+      }
+    }
+  };
+} // namespace details
+
+// Unindents the string in `buf` in place,
+// and returns the length of the unindented string.
+//
+// The unindented string is stored at the beginning of `buf`,
+// and the result is the same as `unindent(str)`. This function never
+// allocates, because the unindented string is never longer than `buf`.
+//
+// Example:
+// ```cpp
+//  char buf[] = "\n    foo\n      bar\n";
+//  auto len = mitama::unindent::unindent_in_place({ buf, std::strlen(buf) });
+//  // std::string_view(buf, len) == "foo\n  bar"
+// ```
+template <typename CharT>
+inline std::size_t
+unindent_in_place(std::span<CharT> buf) noexcept {
+  return details::unindent_to<details::simd_scanner>(
+      std::basic_string_view<CharT>(buf.data(), buf.size()), buf.data()
+  );
+}
+
+// (so that `unindent_in_place({ buf, len })` deduces `char`)
+inline std::size_t
+unindent_in_place(std::span<char> buf) noexcept {
+  return unindent_in_place<char>(buf);
+}
+
+// Unindents `str` in place (without reallocation),
+// and returns the length of the unindented string.
+template <typename CharT, class Traits, class Allocator>
+inline std::size_t
+unindent_in_place(std::basic_string<CharT, Traits, Allocator>& str) noexcept {
+  str.resize(unindent_in_place(std::span<CharT>(str)));
+  return str.size();
+}
+
+// Folds the string in `buf` in place,
+// and returns the length of the folded string.
+//
+// The folded string is stored at the beginning of `buf`,
+// and the result is the same as `fold(str)`. This function never allocates.
+template <typename CharT>
+inline std::size_t
+fold_in_place(std::span<CharT> buf) noexcept {
+  const std::size_t size = unindent_in_place(buf);
+  return details::fold_to<details::simd_scanner>(
+      std::basic_string_view<CharT>(buf.data(), size), buf.data()
+  );
+}
+
+// (so that `fold_in_place({ buf, len })` deduces `char`)
+inline std::size_t
+fold_in_place(std::span<char> buf) noexcept {
+  return fold_in_place<char>(buf);
+}
+
+// Folds `str` in place (without reallocation),
+// and returns the length of the folded string.
+template <typename CharT, class Traits, class Allocator>
+inline std::size_t
+fold_in_place(std::basic_string<CharT, Traits, Allocator>& str) noexcept {
+  str.resize(fold_in_place(std::span<CharT>(str)));
+  return str.size();
+}
+
+// Returns the unindented string of `str` at runtime.
+//
+// The result is the same as `_i` for the same string (of any character type).
+//
+// Example:
+// ```cpp
+//  std::string text = load_template("foo.py.in");
+//  std::string unindented_str = mitama::unindent::unindent(text);
+// ```
+template <typename CharT>
+[[nodiscard]] inline std::basic_string<CharT>
+unindent(std::basic_string_view<CharT> str) {
+  std::basic_string<CharT> result(str);
+  unindent_in_place(result);
+  return result;
+}
+
+template <typename CharT>
+[[nodiscard]] inline std::basic_string<CharT>
+unindent(const CharT* str) {
+  return unindent(std::basic_string_view<CharT>(str));
+}
+
+template <typename CharT, class Traits, class Allocator>
+[[nodiscard]] inline std::basic_string<CharT>
+unindent(const std::basic_string<CharT, Traits, Allocator>& str) {
+  return unindent(std::basic_string_view<CharT>(str.data(), str.size()));
+}
+
+// Returns the unindented string of `str` allocated with `alloc`
+// (e.g. `std::pmr::polymorphic_allocator` of an arena).
+//
+// Example:
+// ```cpp
+//  std::pmr::monotonic_buffer_resource arena;
+//  std::pmr::string unindented_str = mitama::unindent::unindent(
+//      text, std::pmr::polymorphic_allocator<char>(&arena)
+//  );
+// ```
+template <typename CharT, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator>
+unindent(std::basic_string_view<CharT> str, const Allocator& alloc) {
+  details::allocated_string<CharT, Allocator> result(str, alloc);
+  unindent_in_place(result);
+  return result;
+}
+
+template <typename CharT, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator>
+unindent(const CharT* str, const Allocator& alloc) {
+  return unindent(std::basic_string_view<CharT>(str), alloc);
+}
+
+template <typename CharT, class Traits, class StrAllocator, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator> unindent(
+    const std::basic_string<CharT, Traits, StrAllocator>& str,
+    const Allocator& alloc
+) {
+  return unindent(std::basic_string_view<CharT>(str.data(), str.size()), alloc);
+}
+
+// Returns the folded string of `str` at runtime.
+//
+// The result is the same as `_i1` for the same string (of any character
+// type).
+//
+// Example:
+// ```cpp
+//  std::string text = load_template("command.in");
+//  std::string folded_str = mitama::unindent::fold(text);
+// ```
+template <typename CharT>
+[[nodiscard]] inline std::basic_string<CharT>
+fold(std::basic_string_view<CharT> str) {
+  std::basic_string<CharT> result(str);
+  fold_in_place(result);
+  return result;
+}
+
+template <typename CharT>
+[[nodiscard]] inline std::basic_string<CharT>
+fold(const CharT* str) {
+  return fold(std::basic_string_view<CharT>(str));
+}
+
+template <typename CharT, class Traits, class Allocator>
+[[nodiscard]] inline std::basic_string<CharT>
+fold(const std::basic_string<CharT, Traits, Allocator>& str) {
+  return fold(std::basic_string_view<CharT>(str.data(), str.size()));
+}
+
+// Returns the folded string of `str` allocated with `alloc`
+// (e.g. `std::pmr::polymorphic_allocator` of an arena).
+template <typename CharT, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator>
+fold(std::basic_string_view<CharT> str, const Allocator& alloc) {
+  details::allocated_string<CharT, Allocator> result(str, alloc);
+  fold_in_place(result);
+  return result;
+}
+
+template <typename CharT, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator>
+fold(const CharT* str, const Allocator& alloc) {
+  return fold(std::basic_string_view<CharT>(str), alloc);
+}
+
+template <typename CharT, class Traits, class StrAllocator, class Allocator>
+[[nodiscard]] inline details::allocated_string<CharT, Allocator> fold(
+    const std::basic_string<CharT, Traits, StrAllocator>& str,
+    const Allocator& alloc
+) {
+  return fold(std::basic_string_view<CharT>(str.data(), str.size()), alloc);
+}
+} // namespace mitama::unindent
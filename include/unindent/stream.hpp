@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unindent/runtime.hpp>
+#include <utility>
+
+namespace mitama::unindent
+{
+// This is a chunk-fed scanner computing the indent removed by `unindent`.
+//
+// [Note: Feeding the whole string in chunks gives the same indent as
+// `unindent` does, so that it can be used as the first pass of
+// `basic_stream_unindenter`. The memory used does not depend on the
+// length of the string. — end note]
+template <typename CharT>
+class basic_indent_meter
+{
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  std::size_t min_ = none;
+  // the minimum indent of the lines of spaces only since the last line
+  // with contents (removed with the trailing spaces unless followed by one)
+  std::size_t pending_ = none;
+  std::size_t spaces_ = 0;
+  bool in_indent_ = true;
+
+public:
+  void feed(std::basic_string_view<CharT> chunk) noexcept {
+    using scanner = details::simd_scanner;
+    std::size_t pos = 0;
+    const std::size_t size = chunk.size();
+
+    while (pos < size) {
+      if (in_indent_) {
+        const std::size_t spaces = scanner::count_spaces(chunk, pos, none);
+        spaces_ += spaces;
+        pos += spaces;
+        if (pos == size)
+          break; // the indent continues to the next chunk
+        if (chunk[pos] == CharT('\n')) {
+          // a line of spaces only is not an empty line
+          if (spaces_ > 0)
+            pending_ = std::min(pending_, spaces_);
+          spaces_ = 0;
+          ++pos;
+          continue;
+        }
+        min_ = std::min({ min_, pending_, spaces_ });
+        pending_ = none;
+        in_indent_ = false;
+      }
+      pos = scanner::find_return(chunk, pos);
+      if (pos < size) {
+        ++pos;
+        spaces_ = 0;
+        in_indent_ = true;
+      }
+    }
+  }
+
+  // the indent of the string fed so far
+  [[nodiscard]] std::size_t indent() const noexcept {
+    return min_ == none ? 0 : min_;
+  }
+};
+
+using indent_meter = basic_indent_meter<char>;
+
+// This is a chunk-fed unindenter writing the result to a sink.
+//
+// template parameters:
+// - `CharT`: a character type of the string.
+// - `Sink`: a function object invoked with `basic_string_view<CharT>` for
+// each piece of the result.
+//
+// [Note: Feeding the whole string in chunks and calling `finish()` writes
+// the same string as `unindent` does, given the indent computed by
+// `basic_indent_meter`. Only the spaces and returns after the last
+// character written are held (since they are removed if they are trailing),
+// so that the memory used is bounded by the longest run of them, not by the
+// length of the string. — end note]
+template <typename CharT, std::invocable<std::basic_string_view<CharT>> Sink>
+class basic_stream_unindenter
+{
+  std::size_t indent_;
+  Sink sink_;
+  std::basic_string<CharT> pending_ = {};
+  std::size_t removed_ = 0; // the indent removed from the current line
+  bool started_ = false;    // leading returns are removed
+
+public:
+  basic_stream_unindenter(std::size_t indent, Sink sink)
+      : indent_{ indent }, sink_{ std::move(sink) } {}
+
+  void feed(std::basic_string_view<CharT> chunk) {
+    using scanner = details::simd_scanner;
+    std::size_t pos = 0;
+    const std::size_t size = chunk.size();
+
+    if (not started_) {
+      while (pos < size and chunk[pos] == CharT('\n'))
+        ++pos;
+      started_ = pos < size;
+    }
+    while (pos < size) {
+      if (removed_ < indent_) {
+        const std::size_t spaces =
+            scanner::count_spaces(chunk, pos, indent_ - removed_);
+        removed_ += spaces;
+        pos += spaces;
+        if (pos == size)
+          break; // the indent continues to the next chunk
+        removed_ = indent_;
+      }
+
+      const std::size_t end = scanner::find_return(chunk, pos);
+      const auto line = chunk.substr(pos, end - pos);
+      if (const auto last = line.find_last_not_of(CharT(' '));
+          last != line.npos) {
+        flush();
+        std::invoke(sink_, line.substr(0, last + 1));
+        pending_.assign(line.size() - last - 1, CharT(' '));
+      } else {
+        pending_.append(line);
+      }
+      pos = end;
+      if (pos < size) {
+        pending_.push_back(CharT('\n'));
+        removed_ = 0;
+        ++pos;
+      }
+    }
+  }
+
+  // finishes the string (trailing spaces and returns are removed)
+  void finish() noexcept {
+    pending_.clear();
+  }
+
+  [[nodiscard]] Sink& sink() noexcept {
+    return sink_;
+  }
+
+  [[nodiscard]] const Sink& sink() const noexcept {
+    return sink_;
+  }
+
+private:
+  void flush() {
+    if (not pending_.empty()) {
+      std::invoke(sink_, std::basic_string_view<CharT>(pending_));
+      pending_.clear();
+    }
+  }
+};
+
+namespace details
+{
+  // sink folding the unindented string written to `Sink`
+  // (the chunk-fed version of `fold_to`)
+  template <typename CharT, class Sink>
+  class fold_sink
+  {
+    Sink sink_;
+    std::size_t returns_ = 0;
+
+  public:
+    explicit fold_sink(Sink sink) : sink_{ std::move(sink) } {}
+
+    void operator()(std::basic_string_view<CharT> chunk) {
+      std::size_t pos = 0;
+      const std::size_t size = chunk.size();
+
+      while (pos < size) {
+        if (chunk[pos] == CharT('\n')) {
+          ++returns_;
+          ++pos;
+          continue;
+        }
+        // Replace multiple returns with a single return
+        // and replace a single return with a space.
+        if (returns_ > 1) {
+          const CharT c = CharT('\n');
+          std::invoke(sink_, std::basic_string_view<CharT>(&c, 1));
+        } else if (returns_ == 1) {
+          const CharT c = CharT(' ');
+          std::invoke(sink_, std::basic_string_view<CharT>(&c, 1));
+        }
+        returns_ = 0; // reset here
+
+        const std::size_t end = simd_scanner::find_return(chunk, pos);
+        std::invoke(sink_, chunk.substr(pos, end - pos));
+        pos = end;
+      }
+    }
+
+    Sink& base() noexcept {
+      return sink_;
+    }
+
+    const Sink& base() const noexcept {
+      return sink_;
+    }
+  };
+
+  // sink copying the string to an output iterator
+  template <typename CharT, class OutputIt>
+  class iterator_sink
+  {
+    OutputIt out_;
+
+  public:
+    explicit iterator_sink(OutputIt out) : out_{ std::move(out) } {}
+
+    void operator()(std::basic_string_view<CharT> chunk) {
+      out_ = std::ranges::copy(chunk, std::move(out_)).out;
+    }
+
+    OutputIt& base() noexcept {
+      return out_;
+    }
+  };
+
+  // `Out` as a sink of `basic_stream_unindenter`
+  template <typename CharT, class Out>
+  auto
+  to_sink(Out out) {
+    if constexpr (std::invocable<Out&, std::basic_string_view<CharT>>) {
+      return out;
+    } else {
+      static_assert(std::output_iterator<Out, CharT>);
+      return iterator_sink<CharT, Out>{ std::move(out) };
+    }
+  }
+
+  inline constexpr std::size_t stream_chunk_size = 64 * 1024;
+
+  // feeds `in` to `editor` in chunks
+  template <typename CharT, class Traits, class Editor>
+  void
+  feed_stream(std::basic_istream<CharT, Traits>& in, Editor& editor) {
+    std::basic_string<CharT> chunk(stream_chunk_size, CharT('\0'));
+    while (in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()))
+           or in.gcount() > 0) {
+      editor.feed(std::basic_string_view<CharT>(
+          chunk.data(), static_cast<std::size_t>(in.gcount())
+      ));
+    }
+  }
+} // namespace details
+
+// This is a chunk-fed folder writing the result to a sink.
+//
+// [Note: Same as `basic_stream_unindenter`, but writes the same string as
+// `fold` does. The returns are carried over the chunks as a counter, as in
+// `fold_lines`. — end note]
+template <typename CharT, std::invocable<std::basic_string_view<CharT>> Sink>
+class basic_stream_folder
+{
+  basic_stream_unindenter<CharT, details::fold_sink<CharT, Sink>> unindenter_;
+
+public:
+  basic_stream_folder(std::size_t indent, Sink sink)
+      : unindenter_{ indent,
+                     details::fold_sink<CharT, Sink>{ std::move(sink) } } {}
+
+  void feed(std::basic_string_view<CharT> chunk) {
+    unindenter_.feed(chunk);
+  }
+
+  // finishes the string (trailing spaces and returns are removed)
+  void finish() noexcept {
+    unindenter_.finish();
+  }
+
+  [[nodiscard]] Sink& sink() noexcept {
+    return unindenter_.sink().base();
+  }
+
+  [[nodiscard]] const Sink& sink() const noexcept {
+    return unindenter_.sink().base();
+  }
+};
+
+// Returns `basic_stream_unindenter<char, ...>` writing to `out`,
+// which is a function object taking `std::string_view` or an output iterator.
+//
+// Example:
+// ```cpp
+//  auto unindenter = mitama::unindent::make_stream_unindenter(
+//      indent, std::ostreambuf_iterator<char>(std::cout));
+//  for (std::string_view chunk : chunks)
+//    unindenter.feed(chunk);
+//  unindenter.finish();
+// ```
+template <class Out>
+[[nodiscard]] auto
+make_stream_unindenter(std::size_t indent, Out out) {
+  auto sink = details::to_sink<char>(std::move(out));
+  return basic_stream_unindenter<char, decltype(sink)>{ indent,
+                                                        std::move(sink) };
+}
+
+// Returns `basic_stream_folder<char, ...>` writing to `out`,
+// which is a function object taking `std::string_view` or an output iterator.
+template <class Out>
+[[nodiscard]] auto
+make_stream_folder(std::size_t indent, Out out) {
+  auto sink = details::to_sink<char>(std::move(out));
+  return basic_stream_folder<char, decltype(sink)>{ indent, std::move(sink) };
+}
+
+// Returns the indent of the rest of `in`, read in chunks.
+template <typename CharT, class Traits>
+[[nodiscard]] inline std::size_t
+measure_indent(std::basic_istream<CharT, Traits>& in) {
+  basic_indent_meter<CharT> meter;
+  details::feed_stream(in, meter);
+  return meter.indent();
+}
+
+// Writes the unindented rest of `in` to `out` in chunks,
+// where `indent` is the indent of the rest of `in` (see `measure_indent`).
+//
+// `out` is a function object taking `std::basic_string_view<CharT>` or an
+// output iterator.
+//
+// Example:
+// ```cpp
+//  std::ifstream in("report.txt", std::ios::binary);
+//  const auto indent = mitama::unindent::measure_indent(in);
+//  in.clear();
+//  in.seekg(0);
+//  mitama::unindent::unindent_stream(
+//      in, indent, std::ostreambuf_iterator<char>(std::cout));
+// ```
+template <typename CharT, class Traits, class Out>
+void
+unindent_stream(
+    std::basic_istream<CharT, Traits>& in, std::size_t indent, Out out
+) {
+  auto sink = details::to_sink<CharT>(std::move(out));
+  basic_stream_unindenter<CharT, decltype(sink)> unindenter{ indent,
+                                                             std::move(sink) };
+  details::feed_stream(in, unindenter);
+  unindenter.finish();
+}
+
+// Writes the folded rest of `in` to `out` in chunks,
+// where `indent` is the indent of the rest of `in` (see `measure_indent`).
+//
+// `out` is a function object taking `std::basic_string_view<CharT>` or an
+// output iterator.
+template <typename CharT, class Traits, class Out>
+void
+fold_stream(
+    std::basic_istream<CharT, Traits>& in, std::size_t indent, Out out
+) {
+  auto sink = details::to_sink<CharT>(std::move(out));
+  basic_stream_folder<CharT, decltype(sink)> folder{ indent, std::move(sink) };
+  details::feed_stream(in, folder);
+  folder.finish();
+}
+} // namespace mitama::unindent
@@ -0,0 +1,123 @@
+// This is the module interface unit of `mitama.unindent`, exporting the
+// entities of `<unindent/unindent.hpp>`, `<unindent/runtime.hpp>`,
+// `<unindent/stream.hpp>`, `<unindent/compressed.hpp>`,
+// `<unindent/batch.hpp>`, `<unindent/cache.hpp>` and
+// `<unindent/registry.hpp>`. [Example:
+//   ```
+//   import mitama.unindent;
+//   using namespace mitama::unindent::literals;
+//
+//   constexpr auto query = R"(
+//     SELECT * FROM users
+//      WHERE id = {}
+//   )"_i;
+//   ```
+// — end example]
+//
+// [Note: The headers are included in the global module fragment, so that
+// the module and the headers can be used together in a program (e.g. in
+// TUs not yet migrated). The standard library is not exported; importers
+// include the standard headers they use (e.g. `<string>` for `to_str()`).
+// — end note]
+module;
+
+#include <unindent/batch.hpp>
+#include <unindent/cache.hpp>
+#include <unindent/compressed.hpp>
+#include <unindent/registry.hpp>
+#include <unindent/runtime.hpp>
+#include <unindent/stream.hpp>
+#include <unindent/unindent.hpp>
+
+export module mitama.unindent;
+
+export namespace mitama::unindent
+{
+// <unindent/unindent.hpp>
+using mitama::unindent::basic_fixed_string;
+using mitama::unindent::char_stage;
+using mitama::unindent::chunks;
+using mitama::unindent::compose;
+using mitama::unindent::concat;
+using mitama::unindent::edited_string;
+using mitama::unindent::embedded;
+using mitama::unindent::fixed_string;
+using mitama::unindent::folded;
+using mitama::unindent::indented;
+using mitama::unindent::match;
+using mitama::unindent::minified_json;
+using mitama::unindent::minified_sql;
+using mitama::unindent::string_hash;
+using mitama::unindent::unindented;
+using mitama::unindent::verbatim;
+
+using mitama::unindent::operator<=>;
+using mitama::unindent::operator==;
+using mitama::unindent::operator!=;
+using mitama::unindent::operator<;
+using mitama::unindent::operator>;
+using mitama::unindent::operator<<;
+using mitama::unindent::operator+;
+
+// <unindent/runtime.hpp>
+using mitama::unindent::fold;
+using mitama::unindent::fold_in_place;
+using mitama::unindent::unindent;
+using mitama::unindent::unindent_in_place;
+
+// <unindent/stream.hpp>
+using mitama::unindent::basic_indent_meter;
+using mitama::unindent::basic_stream_folder;
+using mitama::unindent::basic_stream_unindenter;
+using mitama::unindent::fold_stream;
+using mitama::unindent::indent_meter;
+using mitama::unindent::make_stream_folder;
+using mitama::unindent::make_stream_unindenter;
+using mitama::unindent::measure_indent;
+using mitama::unindent::unindent_stream;
+
+// <unindent/compressed.hpp>
+using mitama::unindent::compressed;
+using mitama::unindent::compressed_string;
+
+// <unindent/batch.hpp>
+using mitama::unindent::basic_batch;
+using mitama::unindent::batch;
+using mitama::unindent::fold_batch;
+using mitama::unindent::unindent_batch;
+
+// <unindent/cache.hpp>
+using mitama::unindent::basic_cached_string;
+using mitama::unindent::basic_edit_cache;
+using mitama::unindent::cache_stats;
+using mitama::unindent::cached_string;
+using mitama::unindent::edit_cache;
+
+// <unindent/registry.hpp>
+using mitama::unindent::editor_kind;
+using mitama::unindent::name_of;
+using mitama::unindent::registry_entry;
+using mitama::unindent::scan_registry;
+} // namespace mitama::unindent
+
+// the editors of the literals (e.g. for `compose`)
+export namespace mitama::unindent::details
+{
+using mitama::unindent::details::as_is;
+using mitama::unindent::details::operator<<; // of `reindent(n)`
+using mitama::unindent::details::to_folded;
+using mitama::unindent::details::to_minified_json;
+using mitama::unindent::details::to_minified_sql;
+using mitama::unindent::details::to_unindented;
+} // namespace mitama::unindent::details
+
+export namespace mitama::unindent::inline literals
+{
+using mitama::unindent::literals::operator""_i;
+using mitama::unindent::literals::operator""_i1;
+using mitama::unindent::literals::operator""_i1v;
+using mitama::unindent::literals::operator""_ijson;
+using mitama::unindent::literals::operator""_isql;
+using mitama::unindent::literals::operator""_iv;
+using mitama::unindent::literals::operator""_iz;
+} // namespace mitama::unindent::inline literals
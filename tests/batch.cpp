@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "corpus.hpp"
+#include <string>
+#include <string_view>
+#include <unindent/batch.hpp>
+#include <vector>
+
+namespace
+{
+#define UNINDENT_CORPUS_ENTRY(str) std::string_view(str),
+const std::vector<std::string_view> corpus = { UNINDENT_CORPUS(
+    UNINDENT_CORPUS_ENTRY
+) };
+#undef UNINDENT_CORPUS_ENTRY
+
+// the batch editors give the same results as the runtime editors
+template <class BatchEdit, class Edit>
+void
+check_batch(
+    const std::vector<std::string_view>& inputs, BatchEdit batch_edit,
+    Edit edit
+) {
+  for (unsigned jobs : { 1u, 4u, 0u }) {
+    const mitama::unindent::batch results = batch_edit(inputs, jobs);
+    REQUIRE(results.size() == inputs.size());
+    REQUIRE(results.offsets().size() == inputs.size() + 1);
+    std::string joined;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      REQUIRE(results[i] == edit(inputs[i]));
+      REQUIRE(results.offsets()[i] == joined.size());
+      joined += results[i];
+    }
+    REQUIRE(results.arena() == joined);
+  }
+}
+} // namespace
+
+TEST_CASE("batch corpus#1", "[batch]") {
+  auto unindent_batch = [](const auto& inputs, unsigned jobs) {
+    return mitama::unindent::unindent_batch(inputs, jobs);
+  };
+  auto fold_batch = [](const auto& inputs, unsigned jobs) {
+    return mitama::unindent::fold_batch(inputs, jobs);
+  };
+  auto unindent = [](std::string_view str) {
+    return mitama::unindent::unindent(str);
+  };
+  auto fold = [](std::string_view str) {
+    return mitama::unindent::fold(str);
+  };
+
+  check_batch(corpus, unindent_batch, unindent);
+  check_batch(corpus, fold_batch, fold);
+
+  // large enough to be edited on several threads
+  std::vector<std::string_view> inputs;
+  for (std::size_t i = 0; i < 20000; ++i)
+    inputs.push_back(corpus[i % corpus.size()]);
+  check_batch(inputs, unindent_batch, unindent);
+  check_batch(inputs, fold_batch, fold);
+
+  REQUIRE(mitama::unindent::unindent_batch({}).empty());
+  REQUIRE(mitama::unindent::unindent_batch({}).offsets().empty());
+}
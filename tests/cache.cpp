@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "corpus.hpp"
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unindent/cache.hpp>
+#include <vector>
+
+namespace
+{
+#define UNINDENT_CORPUS_ENTRY(str) std::string_view(str),
+const std::vector<std::string_view> corpus = { UNINDENT_CORPUS(
+    UNINDENT_CORPUS_ENTRY
+) };
+#undef UNINDENT_CORPUS_ENTRY
+} // namespace
+
+TEST_CASE("edit_cache#1", "[cache]") {
+  mitama::unindent::edit_cache cache(1024, 4);
+  for (auto input : corpus) {
+    REQUIRE(cache.unindent(input) == mitama::unindent::unindent(input));
+    REQUIRE(cache.fold(input) == mitama::unindent::fold(input));
+  }
+  // cached by the content, not by the address
+  for (auto input : corpus) {
+    const std::string copy(input);
+    REQUIRE(cache.unindent(copy) == mitama::unindent::unindent(input));
+    REQUIRE(cache.fold(copy) == mitama::unindent::fold(input));
+  }
+
+  const auto stats = cache.stats();
+  CHECK(stats.hits + stats.misses == corpus.size() * 4);
+  CHECK(stats.hits >= corpus.size() * 2);
+  CHECK(stats.evictions == 0);
+  CHECK(stats.size == stats.misses);
+
+  const auto first = cache.unindent(corpus.front());
+  CHECK(cache.unindent(corpus.front()).data() == first.data()); // shared
+  cache.clear();
+  CHECK(cache.stats().size == 0);
+  CHECK(first == mitama::unindent::unindent(corpus.front())); // still alive
+}
+
+TEST_CASE("edit_cache eviction#1", "[cache]") {
+  mitama::unindent::edit_cache cache(4, 1);
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 16; ++i)
+    inputs.push_back("\n  line " + std::to_string(i) + "\n");
+
+  const auto kept = cache.unindent(inputs[0]);
+  for (const auto& input : inputs)
+    REQUIRE(cache.unindent(input) == mitama::unindent::unindent(input));
+  const auto stats = cache.stats();
+  CHECK(stats.size == 4);
+  CHECK(stats.evictions == 12);
+  CHECK(kept == "line 0"); // stable after the eviction
+}
+
+TEST_CASE("edit_cache threads#1", "[cache]") {
+  mitama::unindent::edit_cache cache(64);
+  std::atomic<int> mismatches = 0; // (the assertions are not thread-safe)
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 200; ++i) {
+          for (auto input : corpus) {
+            if (cache.fold(input) != mitama::unindent::fold(input))
+              ++mismatches;
+          }
+        }
+      });
+    }
+  }
+  CHECK(mismatches == 0);
+  const auto stats = cache.stats();
+  CHECK(stats.hits + stats.misses == corpus.size() * 800);
+  CHECK(stats.size <= 64);
+}
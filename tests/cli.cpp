@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if !defined(UNINDENT_CLI)
+#  error "UNINDENT_CLI is the path of the unindent executable"
+#endif
+
+namespace
+{
+namespace fs = std::filesystem;
+
+// runs `unindent args` and returns the exit status
+int
+run_cli(const std::string& args) {
+  return std::system(("\"" UNINDENT_CLI "\" " + args).c_str());
+}
+
+void
+write_file(const fs::path& path, const std::string& contents) {
+  std::ofstream(path, std::ios::binary) << contents;
+}
+
+std::string
+read_file(const fs::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  return { std::istreambuf_iterator<char>(in),
+           std::istreambuf_iterator<char>{} };
+}
+
+// a directory removed at the end of a test
+struct scratch_dir
+{
+  fs::path path = fs::temp_directory_path() / "unindent-cli-tests";
+
+  scratch_dir() {
+    fs::remove_all(path);
+    fs::create_directories(path);
+  }
+  ~scratch_dir() {
+    std::error_code ec;
+    fs::remove_all(path, ec);
+  }
+};
+} // namespace
+
+TEST_CASE("in place#1", "[cli]") {
+  const scratch_dir dir;
+  const auto script = dir.path / "script.sh";
+  write_file(script, "\n    echo a\n      echo b\n  ");
+  // the permissions are kept
+  constexpr auto perms = fs::perms::owner_all | fs::perms::group_read
+                         | fs::perms::group_exec | fs::perms::others_read;
+  fs::permissions(script, perms);
+
+  REQUIRE(run_cli("-i \"" + script.string() + "\"") == 0);
+  CHECK(read_file(script) == "echo a\n  echo b\n");
+  CHECK(fs::status(script).permissions() == perms);
+  CHECK(not fs::exists(dir.path / "script.sh.unindent-tmp"));
+}
+
+#if !defined(_WIN32) // (creating symbolic links requires a privilege)
+TEST_CASE("in place#2", "[cli]") {
+  const scratch_dir dir;
+  const auto target = dir.path / "target.txt";
+  const auto link = dir.path / "link.txt";
+  write_file(target, "\n    a\n    b\n");
+  fs::create_symlink(target.filename(), link);
+
+  // the target is edited, and the link is kept
+  REQUIRE(run_cli("-1 -i \"" + link.string() + "\"") == 0);
+  CHECK(fs::is_symlink(fs::symlink_status(link)));
+  CHECK(read_file(target) == "a b\n");
+}
+#endif
+
+TEST_CASE("in place#3", "[cli]") {
+  const scratch_dir dir;
+  const auto file = dir.path / "file.txt";
+  const auto tmp = dir.path / "file.txt.unindent-tmp";
+  write_file(file, "\n    a\n");
+  write_file(tmp, "not ours");
+
+  // an existing file of the temporary name is not overwritten
+  REQUIRE(run_cli("-i \"" + file.string() + "\"") == 0);
+  CHECK(read_file(file) == "a\n");
+  CHECK(read_file(tmp) == "not ours");
+  CHECK(not fs::exists(dir.path / "file.txt.unindent-tmp1"));
+}
+
+#if !defined(_WIN32) // (`ulimit` of the shell)
+TEST_CASE("in place#4", "[cli]") {
+  const scratch_dir dir;
+  const auto file = dir.path / "file.txt";
+  write_file(file, "\n    a\n");
+
+  // the temporary file is removed when the write fails (with EFBIG past the
+  // limit of the size of files)
+  const auto command = "trap '' XFSZ; ulimit -f 0; \"" UNINDENT_CLI "\" -i \""
+                       + file.string() + "\" 2>/dev/null";
+  CHECK(std::system(command.c_str()) != 0);
+  CHECK(read_file(file) == "\n    a\n");
+  for (const auto& entry : fs::directory_iterator(dir.path))
+    CHECK(entry.path().filename() == "file.txt");
+}
+#endif
+
+TEST_CASE("options#1", "[cli]") {
+  const scratch_dir dir;
+  const auto errors = dir.path / "errors.txt";
+
+  CHECK(run_cli("-j 2> \"" + errors.string() + "\"") != 0);
+  CHECK(read_file(errors) == "unindent: -j requires a number of jobs\n");
+  CHECK(run_cli("-j 0 2> \"" + errors.string() + "\"") != 0);
+  CHECK(read_file(errors) == "unindent: invalid number of jobs: 0\n");
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unindent/compressed.hpp>
+#include <unindent/runtime.hpp>
+#include <vector>
+
+namespace
+{
+// a large literal with repetitions (as DDL or templates are)
+constexpr mitama::unindent::basic_fixed_string schema = R"(
+  CREATE TABLE users (
+    id INTEGER PRIMARY KEY,
+    name TEXT NOT NULL,
+    email TEXT NOT NULL UNIQUE
+  );
+  CREATE TABLE posts (
+    id INTEGER PRIMARY KEY,
+    user_id INTEGER NOT NULL REFERENCES users (id),
+    title TEXT NOT NULL,
+    body TEXT NOT NULL
+  );
+  CREATE TABLE comments (
+    id INTEGER PRIMARY KEY,
+    post_id INTEGER NOT NULL REFERENCES posts (id),
+    user_id INTEGER NOT NULL REFERENCES users (id),
+    body TEXT NOT NULL
+  );
+)";
+} // namespace
+
+TEST_CASE("compressed#1", "[compressed]") {
+  using namespace mitama::unindent::literals;
+  using namespace std::literals;
+  using mitama::unindent::compressed;
+  using mitama::unindent::unindented;
+
+  // (edited at runtime, so that the edited string of `unindented` is not in
+  // the binary)
+  const std::string expected = mitama::unindent::unindent(schema.to_str());
+  constexpr auto z = compressed<schema>;
+  static_assert(z.size() == unindented<schema>.size());
+  static_assert(z.hash() == unindented<schema>.hash());
+  // (the repetitions of the schema)
+  static_assert(z.compressed_size() * 2 < z.size());
+
+  REQUIRE(z.size() == expected.size());
+  REQUIRE(z.to_str() == expected);
+  REQUIRE(z.c_str()[z.size()] == '\0');
+  REQUIRE(z == expected);
+
+  // decompressed once, on all threads
+  std::vector<std::string> results(8);
+  {
+    std::vector<std::jthread> threads;
+    for (auto& result : results)
+      threads.emplace_back([&result] { result = compressed<schema>.to_str(); });
+  }
+  for (const auto& result : results)
+    REQUIRE(result == expected);
+
+  constexpr auto greeting = R"(
+    Hello, {}!
+      {} {} {}
+  )"_iz;
+  REQUIRE(greeting.format("world", 1, 1, 1) == "Hello, world!\n  1 1 1"sv);
+  std::pmr::monotonic_buffer_resource arena;
+  const std::pmr::string str = greeting.format(
+      std::allocator_arg, std::pmr::polymorphic_allocator<char>(&arena),
+      "world", 1, 1, 1
+  );
+  REQUIRE(str == "Hello, world!\n  1 1 1"sv);
+  REQUIRE(""_iz.to_str().empty());
+}
@@ -0,0 +1,30 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+// only the core (neither <unindent/format.hpp> nor <unindent/ostream.hpp>)
+#include <unindent/core.hpp>
+
+using namespace mitama::unindent::literals;
+using namespace std::literals;
+
+TEST_CASE("core#1", "[core]") {
+  constexpr auto str = R"(
+    def foo():
+      print("Hello")
+  )"_i;
+  static_assert(str == "def foo():\n  print(\"Hello\")"sv);
+  static_assert(R"(
+    a
+    b
+  )"_i1v == "a b"sv);
+  static_assert(str.lines().size() == 2);
+  static_assert(str.lines()[1] == "  print(\"Hello\")"sv);
+  static_assert(std::random_access_iterator<decltype(str.lines().begin())>);
+
+  std::string reindented;
+  str.reindent(2).copy_to(std::back_inserter(reindented));
+  REQUIRE(reindented == "def foo():\n    print(\"Hello\")");
+  REQUIRE((str + "x"_i).size() == str.size() + 1);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+// strings shared by the tests of the compile-time and runtime editors
+//
+// `UNINDENT_CORPUS(X)` expands `X(str)` for each string literal `str`.
+#define UNINDENT_CORPUS(X)                                              \
+  X("")                                                                 \
+  X("\n\n  \n")                                                         \
+  X("abc")                                                              \
+  X("  abc  ")                                                          \
+  X("\n"                                                                \
+    "    def foo():\n"                                                  \
+    "      print(\"Hello\")\n"                                          \
+    "      print(\"World\")\n"                                          \
+    "  ")                                                               \
+  X("\n"                                                                \
+    "    def foo():\n"                                                  \
+    "      print(\"Hello\")\n"                                          \
+    "\n"                                                                \
+    "      print(\"World\")\n"                                          \
+    "  ")                                                               \
+  X("\n"                                                                \
+    "    This is the first line.\n"                                     \
+    "    This line is appended to the first.\n"                         \
+    "\n"                                                                \
+    "    This line follows a line break.\n"                             \
+    "      This line ends up indented by two spaces.\n"                 \
+    "  ")                                                               \
+  X("\n"                                                                \
+    "       a line of spaces only counts as an indent:\n"               \
+    "     \n"                                                           \
+    "       and keeps the spaces after the indent  \n"                  \
+    "  ")                                                               \
+  X("\n"                                                                \
+    "    paragraph\n"                                                   \
+    "\n"                                                                \
+    "\n"                                                                \
+    "    after two empty lines\n"                                       \
+    "  ")                                                               \
+  X("\n"                                                                \
+    "                  a long indent and a line longer than 32 bytes\n" \
+    "                  {\n"                                             \
+    "                      nested\n"                                    \
+    "                  }\n"                                             \
+    "  ")
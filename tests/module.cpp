@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+
+import mitama.unindent;
+
+using namespace mitama::unindent::literals;
+using namespace std::literals;
+
+TEST_CASE("module#1", "[module]") {
+  constexpr auto query = R"(
+    SELECT *
+      FROM users
+     WHERE id = {}
+  )"_i;
+  static_assert(query == "SELECT *\n  FROM users\n WHERE id = {}"sv);
+  static_assert(query == mitama::unindent::unindented<R"(
+    SELECT *
+      FROM users
+     WHERE id = {}
+  )">);
+  REQUIRE(query.format(42) == "SELECT *\n  FROM users\n WHERE id = 42");
+
+  constexpr auto folded = R"(
+    a
+    b
+  )"_i1;
+  static_assert(folded == "a b"sv);
+  static_assert((query + folded).size() == query.size() + folded.size());
+
+  std::ostringstream os;
+  os << folded;
+  REQUIRE(os.str() == "a b");
+
+  REQUIRE(mitama::unindent::unindent("  a\n    b"sv) == "a\n  b");
+  REQUIRE(R"(
+    a
+    b
+  )"_iz.to_str() == "a\nb");
+}
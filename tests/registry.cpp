@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unindent/unindent.hpp>
+#include <vector>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#elif defined(__APPLE__)
+#  include <mach-o/dyld.h>
+#endif
+
+#if !defined(UNINDENT_ENABLE_REGISTRY)
+#  error "registry.cpp is built with UNINDENT_ENABLE_REGISTRY"
+#endif
+
+// the bounds of the section `unindent_registry` defined by the linker
+// (null if there is no such section)
+//
+// [Note: Only Clang is known to put the descriptors into the section on
+// ELF, since GCC ignores the sections of template instantiations (see
+// "Registry of literals" of README.md). — end note]
+#if defined(__ELF__) && defined(__clang__)
+#  define UNINDENT_TEST_REGISTRY_SECTION
+extern "C" {
+[[gnu::weak]] extern const mitama::unindent::registry_entry
+    __start_unindent_registry[];
+[[gnu::weak]] extern const mitama::unindent::registry_entry
+    __stop_unindent_registry[];
+}
+#endif
+
+namespace
+{
+using namespace mitama::unindent::literals;
+
+// (the literals are given by macros for their raw sizes)
+#define UNINDENT_TEST_QUERY "\n  SELECT id, name\n    FROM users\n"
+#define UNINDENT_TEST_COMMAND "\n  cmake\n  -B build\n"
+constexpr auto query = UNINDENT_TEST_QUERY ""_i;
+constexpr auto command = UNINDENT_TEST_COMMAND ""_i1;
+
+// the path of this executable (empty if unknown)
+std::filesystem::path
+executable_path() {
+#if defined(_WIN32)
+  wchar_t path[MAX_PATH];
+  const DWORD size = ::GetModuleFileNameW(nullptr, path, MAX_PATH);
+  return size == 0 or size == MAX_PATH ? std::filesystem::path()
+                                       : std::filesystem::path(path);
+#elif defined(__APPLE__)
+  char path[4096];
+  std::uint32_t size = sizeof(path);
+  return ::_NSGetExecutablePath(path, &size) == 0 ? std::filesystem::path(path)
+                                                  : std::filesystem::path();
+#elif defined(__linux__)
+  return "/proc/self/exe";
+#else
+  return {};
+#endif
+}
+
+// `entries` has the descriptors of `query` and `command`
+void
+check_registered(std::span<const mitama::unindent::registry_entry> entries) {
+  using mitama::unindent::editor_kind;
+  auto find = [&](std::uint64_t hash, editor_kind editor) {
+    return std::ranges::find_if(entries, [&](const auto& e) {
+      return e.hash == hash and e.editor == editor;
+    });
+  };
+  const auto q = find(query.hash(), editor_kind::unindent);
+  REQUIRE(q != entries.end());
+  CHECK(q->edited_size == query.size());
+  CHECK(q->raw_size == sizeof(UNINDENT_TEST_QUERY) - 1);
+  CHECK(q->preview_view() == "SELECT id, name");
+  const auto c = find(command.hash(), editor_kind::fold);
+  REQUIRE(c != entries.end());
+  CHECK(c->raw_size == sizeof(UNINDENT_TEST_COMMAND) - 1);
+  CHECK(c->preview_view() == "cmake -B build");
+}
+} // namespace
+
+TEST_CASE("registry#1", "[registry]") {
+  using mitama::unindent::editor_kind;
+  using query_type = std::remove_const_t<decltype(query)>;
+  constexpr auto& entry = mitama::unindent::details::registry_entry_of<
+      query_type, sizeof(UNINDENT_TEST_QUERY) - 1,
+      mitama::unindent::details::to_unindented>;
+  static_assert(entry.editor == editor_kind::unindent);
+  static_assert(entry.raw_size == sizeof(UNINDENT_TEST_QUERY) - 1);
+  static_assert(entry.edited_size == query.size());
+  static_assert(entry.hash == query.hash());
+  static_assert(entry.preview_view() == "SELECT id, name");
+
+  using command_type = std::remove_const_t<decltype(command)>;
+  constexpr auto& folded = mitama::unindent::details::registry_entry_of<
+      command_type, sizeof(UNINDENT_TEST_COMMAND) - 1,
+      mitama::unindent::details::to_folded>;
+  static_assert(folded.editor == editor_kind::fold);
+  static_assert(folded.preview_view() == "cmake -B build");
+
+  // found among other bytes (aligned as in a binary)
+  alignas(8) std::array<char, 8 + sizeof(entry) * 2 + 8> image = {};
+  std::memcpy(image.data(), "UNINDREG", 8); // not a descriptor
+  std::memcpy(image.data() + 8, &entry, sizeof(entry));
+  std::memcpy(image.data() + 8 + sizeof(entry), &folded, sizeof(folded));
+  const auto entries = mitama::unindent::scan_registry(image);
+  REQUIRE(entries.size() == 2);
+  CHECK(entries[0].hash == query.hash());
+  CHECK(entries[1].editor == editor_kind::fold);
+  CHECK(mitama::unindent::name_of(entries[1].editor) == "fold");
+}
+
+TEST_CASE("registry#2", "[registry]") {
+  // the descriptors of the literals above are in this executable
+  const auto path = executable_path();
+  if (path.empty())
+    SKIP("the path of the executable is unknown on this platform");
+  std::ifstream in(path, std::ios::binary);
+  REQUIRE(in);
+  const std::vector<char> image(
+      std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}
+  );
+  check_registered(mitama::unindent::scan_registry(image));
+}
+
+TEST_CASE("registry#3", "[registry]") {
+  // the descriptors are in the section
+#if defined(UNINDENT_TEST_REGISTRY_SECTION)
+  REQUIRE(__start_unindent_registry != nullptr);
+  check_registered(
+      std::span(__start_unindent_registry, __stop_unindent_registry)
+  );
+#else
+  SKIP("the section is not supported by this toolchain");
+#endif
+}
@@ -18,3 +18,60 @@ TEST_CASE("issue#1", "[unindent]") {
       unindented_str == "def foo():\n  print(\"Hello\")\n\n  print(\"World\")"sv
   );
 }
+
+// literals of tens of KB compile under the default constexpr limits
+#define UNINDENT_X4(s) s s s s
+#define UNINDENT_LARGE_LITERAL \
+  UNINDENT_X4(UNINDENT_X4(UNINDENT_X4(UNINDENT_X4( \
+      "      SELECT id, name, email, created_at FROM users WHERE id = ?;\n" \
+      "        -- indented comment line\n"))))
+
+TEST_CASE("large literal#1", "[unindent]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto str = "\n" UNINDENT_LARGE_LITERAL "    "_i;
+
+  static_assert(str.to_str().starts_with("SELECT id, name, email,"sv));
+  static_assert(str.to_str().ends_with("\n  -- indented comment line"sv));
+  // 512 lines lose 6 spaces each and the last return is removed
+  static_assert(
+      str.size() == (sizeof(UNINDENT_LARGE_LITERAL) - 1) - 512 * 6 - 1
+  );
+
+  // the single returns are replaced with spaces
+  constexpr auto folded = "\n" UNINDENT_LARGE_LITERAL "    "_i1;
+  static_assert(folded.size() == str.size());
+  static_assert(folded.to_str().find('\n') == std::string_view::npos);
+  static_assert(folded.to_str().ends_with(";   -- indented comment line"sv));
+}
+
+// literals near the supported size (about 256 KB, see "Large literals" of
+// README.md) compile under the default constexpr limits of GCC
+//
+// [Note: The limits of Clang and MSVC count the evaluation in other units,
+// and the builds for them raise the limits for literals this large.
+// — end note]
+#if defined(__GNUC__) && !defined(__clang__)
+#  define UNINDENT_X2(s) s s
+// 247.5 KiB: 10 times UNINDENT_LARGE_LITERAL
+#  define UNINDENT_HUGE_LITERAL \
+    UNINDENT_X4(UNINDENT_X2(UNINDENT_LARGE_LITERAL)) \
+    UNINDENT_X2(UNINDENT_LARGE_LITERAL)
+
+TEST_CASE("large literal#2", "[unindent]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  static_assert(sizeof(UNINDENT_HUGE_LITERAL) - 1 == 253440);
+
+  constexpr auto str = "\n" UNINDENT_HUGE_LITERAL "    "_i;
+  static_assert(
+      str.size() == (sizeof(UNINDENT_HUGE_LITERAL) - 1) - 5120 * 6 - 1
+  );
+  static_assert(str.to_str().ends_with("\n  -- indented comment line"sv));
+
+  constexpr auto folded = "\n" UNINDENT_HUGE_LITERAL "    "_i1;
+  static_assert(folded.size() == str.size());
+  static_assert(folded.to_str().ends_with(";   -- indented comment line"sv));
+  REQUIRE(folded.to_str().find('\n') == std::string_view::npos);
+}
+#endif
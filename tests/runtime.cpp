@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "corpus.hpp"
+#include <memory_resource>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unindent/runtime.hpp>
+
+TEST_CASE("runtime unindent#1", "[runtime]") {
+  using namespace std::literals;
+  REQUIRE(
+      mitama::unindent::unindent(R"(
+    def foo():
+      print("Hello")
+      print("World")
+  )")
+      == "def foo():\n  print(\"Hello\")\n  print(\"World\")"sv
+  );
+}
+
+TEST_CASE("runtime fold#1", "[runtime]") {
+  using namespace std::literals;
+  REQUIRE(
+      mitama::unindent::fold(R"(
+    first
+    second
+
+    third
+  )")
+      == "first second\nthird"sv
+  );
+}
+
+// the runtime editors give the same results as the compile-time editors
+TEST_CASE("runtime char types#1", "[runtime]") {
+  using namespace std::literals;
+  REQUIRE(mitama::unindent::unindent(u"\n    a\n      b\n  ") == u"a\n  b"s);
+  REQUIRE(mitama::unindent::fold(L"\n    a\n    b\n  "s) == L"a b"s);
+  std::u32string str = U"\n    a\n\n    b";
+  mitama::unindent::fold_in_place(str);
+  REQUIRE(str == U"a\nb"s);
+}
+
+TEST_CASE("runtime allocator#1", "[runtime]") {
+  using namespace std::literals;
+  // the results are allocated only in the buffer
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()
+  );
+  const std::pmr::polymorphic_allocator<char> alloc(&arena);
+  const auto text = "\n    foo\n      bar\n    baz\n  "s;
+
+  std::pmr::string unindented = mitama::unindent::unindent(text, alloc);
+  REQUIRE(unindented == "foo\n  bar\nbaz");
+  REQUIRE(unindented.get_allocator() == alloc);
+  std::pmr::string folded = mitama::unindent::fold(text.c_str(), alloc);
+  REQUIRE(folded == "foo   bar baz");
+  REQUIRE(
+      mitama::unindent::unindent(std::string_view(text), alloc)
+      == std::string_view(mitama::unindent::unindent(text))
+  );
+}
+
+TEST_CASE("runtime corpus#1", "[runtime]") {
+  using mitama::unindent::folded;
+  using mitama::unindent::unindented;
+#define UNINDENT_CHECK_CORPUS(str)                           \
+  REQUIRE(mitama::unindent::unindent(str) == unindented<str>); \
+  REQUIRE(mitama::unindent::fold(str) == folded<str>);
+  UNINDENT_CORPUS(UNINDENT_CHECK_CORPUS)
+#undef UNINDENT_CHECK_CORPUS
+}
+
+TEST_CASE("runtime in place#1", "[runtime]") {
+  using namespace std::literals;
+  char buf[] = "\n    foo\n      bar\n  ";
+  std::span<char> span(buf, sizeof(buf) - 1); // without the terminator
+  auto len = mitama::unindent::unindent_in_place(span);
+  REQUIRE(std::string_view(buf, len) == "foo\n  bar"sv);
+
+  std::string str = "\n    foo\n    bar\n\n    baz\n  ";
+  const auto* data = str.data();
+  const auto capacity = str.capacity();
+  REQUIRE(mitama::unindent::fold_in_place(str) == 11);
+  REQUIRE(str == "foo bar\nbaz"sv);
+  REQUIRE(str.data() == data);
+  REQUIRE(str.capacity() == capacity);
+}
+
+// the in-place editors give the same results as the other runtime editors
+TEST_CASE("runtime in place corpus#1", "[runtime]") {
+#define UNINDENT_CHECK_CORPUS(str)                                 \
+  {                                                                \
+    std::string unindented_str = str, folded_str = str;            \
+    mitama::unindent::unindent_in_place(unindented_str);           \
+    mitama::unindent::fold_in_place(folded_str);                   \
+    REQUIRE(unindented_str == mitama::unindent::unindent(str));    \
+    REQUIRE(folded_str == mitama::unindent::fold(str));            \
+  }
+  UNINDENT_CORPUS(UNINDENT_CHECK_CORPUS)
+#undef UNINDENT_CHECK_CORPUS
+}
+
+// the SIMD scanner gives the same results as the scalar scanner
+TEST_CASE("runtime scanner#1", "[runtime]") {
+  namespace details = mitama::unindent::details;
+  std::mt19937 rng(42);
+  constexpr std::string_view alphabet = "    \n ab";
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string str(rng() % 200, ' ');
+    for (auto& c : str)
+      c = alphabet[rng() % alphabet.size()];
+
+    std::string scalar(str.size(), '\0');
+    scalar.resize(details::unindent_to(std::string_view(str), scalar.data()));
+    std::string simd(str.size(), '\0');
+    simd.resize(details::unindent_to<details::simd_scanner>(
+        std::string_view(str), simd.data()
+    ));
+    REQUIRE(simd == scalar);
+
+    std::string folded(scalar.size(), '\0');
+    folded.resize(details::scan_stages_to(
+        std::string_view(scalar), folded.data(), details::fold_lines
+    ));
+    REQUIRE(mitama::unindent::fold(str) == folded);
+  }
+}
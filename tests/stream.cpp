@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "corpus.hpp"
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unindent/stream.hpp>
+
+namespace
+{
+// feeds `str` to `editor` in chunks of `chunk_size`
+void
+feed_chunks(auto& editor, std::string_view str, std::size_t chunk_size) {
+  for (std::size_t pos = 0; pos < str.size(); pos += chunk_size)
+    editor.feed(str.substr(pos, chunk_size));
+  editor.finish();
+}
+
+std::size_t
+indent_of(std::string_view str, std::size_t chunk_size) {
+  mitama::unindent::indent_meter meter;
+  for (std::size_t pos = 0; pos < str.size(); pos += chunk_size)
+    meter.feed(str.substr(pos, chunk_size));
+  return meter.indent();
+}
+
+// the stream editors give the same results as the runtime editors
+void
+check_stream(std::string_view str) {
+  for (std::size_t chunk_size = 1; chunk_size <= 9; ++chunk_size) {
+    const auto indent = indent_of(str, chunk_size);
+
+    std::string unindented_str;
+    auto unindenter = mitama::unindent::make_stream_unindenter(
+        indent, std::back_inserter(unindented_str)
+    );
+    feed_chunks(unindenter, str, chunk_size);
+    REQUIRE(unindented_str == mitama::unindent::unindent(str));
+
+    std::string folded_str;
+    auto folder = mitama::unindent::make_stream_folder(
+        indent, [&](std::string_view s) { folded_str += s; }
+    );
+    feed_chunks(folder, str, chunk_size);
+    REQUIRE(folded_str == mitama::unindent::fold(str));
+  }
+}
+} // namespace
+
+TEST_CASE("stream corpus#1", "[stream]") {
+#define UNINDENT_CHECK_CORPUS(str) check_stream(str);
+  UNINDENT_CORPUS(UNINDENT_CHECK_CORPUS)
+#undef UNINDENT_CHECK_CORPUS
+}
+
+TEST_CASE("stream random#1", "[stream]") {
+  std::mt19937 rng(42);
+  constexpr std::string_view alphabet = "    \n\n ab";
+
+  for (int i = 0; i < 300; ++i) {
+    std::string str(rng() % 100, ' ');
+    for (auto& c : str)
+      c = alphabet[rng() % alphabet.size()];
+    check_stream(str);
+  }
+}
+
+TEST_CASE("stream istream#1", "[stream]") {
+  using namespace std::literals;
+  std::istringstream in(R"(
+    first
+      second
+
+    third
+  )");
+  const auto indent = mitama::unindent::measure_indent(in);
+  REQUIRE(indent == 4);
+
+  std::string unindented_str;
+  in.clear();
+  in.seekg(0);
+  mitama::unindent::unindent_stream(
+      in, indent, std::back_inserter(unindented_str)
+  );
+  REQUIRE(unindented_str == "first\n  second\n\nthird"sv);
+
+  std::string folded_str;
+  in.clear();
+  in.seekg(0);
+  mitama::unindent::fold_stream(in, indent, std::back_inserter(folded_str));
+  REQUIRE(folded_str == "first   second\nthird"sv);
+}
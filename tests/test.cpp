@@ -1,8 +1,17 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstddef>
 #include <format>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <sstream>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unindent/unindent.hpp>
 
 TEST_CASE("CTAD#1", "[fixed_string]") {
@@ -118,6 +127,398 @@ TEST_CASE("format#2", "[folded]") {
   REQUIRE(str == "Hello World"sv);
 }
 
+TEST_CASE("format#3", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto fmt = R"(
+    {{ "name": "{}", "id": {}, "score": {:>6.2f} }}
+    {{ "flag": {}, "char": '{}' }}
+  )"_i;
+  auto str = fmt.format("alice"s, 42, 3.14159, true, 'c');
+  REQUIRE(
+      str
+      == "{ \"name\": \"alice\", \"id\": 42, \"score\":   3.14 }\n"
+         "{ \"flag\": true, \"char\": 'c' }"sv
+  );
+  REQUIRE(fmt.formatted_size("alice"s, 42, 3.14159, true, 'c') == str.size());
+}
+
+TEST_CASE("format#4", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  // manual indexing
+  constexpr auto fmt = R"(
+    {1}-{0}-{1:#x}
+  )"_i;
+  REQUIRE(fmt.format(-12, 255u) == "255--12-0xff"sv);
+  REQUIRE(fmt.formatted_size(-12, 255u) == 12);
+  // nested replacement fields (parsed by std::format)
+  constexpr auto nested = R"(
+    [{:>{}}]
+  )"_i;
+  REQUIRE(nested.format("ab", 4) == "[  ab]"sv);
+  REQUIRE(nested.formatted_size("ab", 4) == 6);
+  // no replacement fields
+  REQUIRE(R"(
+    {{}}
+  )"_i.format() == "{}"sv);
+}
+
+TEST_CASE("format_to#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto fmt = R"(
+    HTTP/1.1 {} {}
+    Content-Length: {:>4}
+  )"_i;
+  constexpr auto expected = "HTTP/1.1 200 OK\nContent-Length:   12"sv;
+
+  std::array<char, 64> buf = {};
+  auto end = fmt.format_to(buf.begin(), 200, "OK", 12);
+  REQUIRE(std::string_view(buf.begin(), end) == expected);
+
+  // truncated
+  auto [out, size] = fmt.format_to_n(buf.begin(), 12, 404, "Not Found", 0);
+  REQUIRE(std::string_view(buf.begin(), out) == "HTTP/1.1 404"sv);
+  REQUIRE(size == 43);
+  REQUIRE(fmt.format_to_n(buf.begin(), 0, 200, "OK", 12).out == buf.begin());
+
+  std::string str = "> ";
+  fmt.append_to(str, 200, "OK", 12);
+  REQUIRE(str == "> "s + std::string(expected));
+  str.clear();
+  const auto capacity = str.capacity();
+  fmt.append_to(str, 200, "OK", 12);
+  REQUIRE(str == expected);
+  REQUIRE(str.capacity() == capacity);
+}
+
+TEST_CASE("format allocator#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()
+  );
+  const std::pmr::polymorphic_allocator<char> alloc(&arena);
+  constexpr auto fmt = R"(
+    HTTP/1.1 {} {}
+    Content-Length: {:>4}
+  )"_i;
+
+  std::pmr::string str = fmt.format(std::allocator_arg, alloc, 200, "OK", 12);
+  REQUIRE(str == "HTTP/1.1 200 OK\nContent-Length:   12");
+  REQUIRE(str.get_allocator() == alloc);
+  // a format string parsed at runtime
+  REQUIRE("{:{}}"_i.format(std::allocator_arg, alloc, 1, 3) == "  1");
+
+  str.clear();
+  fmt.append_to(str, 404, "Not Found", 0);
+  REQUIRE(str == "HTTP/1.1 404 Not Found\nContent-Length:    0");
+}
+
+TEST_CASE("formatter#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto query = R"(
+    SELECT * FROM users
+  )"_i;
+  static constexpr mitama::unindent::basic_fixed_string fs = "abc";
+
+  REQUIRE(std::format("query: {}", query) == "query: SELECT * FROM users");
+  REQUIRE(std::format("[{:>8.3}]", query) == "[     SEL]");
+  REQUIRE(std::format("[{:*^7}]", fs) == "[**abc**]");
+  REQUIRE(std::format("{0}, {0:.1}", "a b"_i1) == "a b, a");
+  REQUIRE(std::format(L"{}|{:>3}", L"x"_i, L"y"_i) == L"x|  y");
+  REQUIRE(R"(
+    {} -- {:>3}
+  )"_i.format("ab"_i, "c"_i) == "ab --   c");
+}
+
+TEST_CASE("bind#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto query = R"(
+    SELECT {} FROM {}
+    WHERE version = {} AND id = {}
+  )"_i.bind<"name, email", "users", 3>();
+  static_assert(
+      query == "SELECT name, email FROM users\nWHERE version = 3 AND id = {}"sv
+  );
+  REQUIRE(query.format(42)
+          == "SELECT name, email FROM users\nWHERE version = 3 AND id = 42"sv);
+
+  // braces in values are escaped, and manual indices are renumbered
+  constexpr auto fmt = R"({2:>3}|{0}|{1}|{3})"_i.bind<"{x}", -7>();
+  static_assert(fmt == "{0:>3}|{{x}}|-7|{1}"sv);
+  REQUIRE(fmt.format(5, false) == "  5|{x}|-7|false"sv);
+}
+
+TEST_CASE("lines#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto str = R"(
+    def foo():
+      print("Hello")
+
+      print("World")
+  )"_i;
+  static_assert(str.line_count() == 4);
+  static_assert(str.line(0) == "def foo():"sv);
+  static_assert(str.line(1) == "  print(\"Hello\")"sv);
+  static_assert(str.line(2).empty());
+  static_assert(str.line(3) == "  print(\"World\")"sv);
+
+  constexpr auto lines = str.lines();
+  static_assert(std::ranges::random_access_range<decltype(lines)>);
+  REQUIRE(lines.size() == 4);
+  REQUIRE(lines[3] == "  print(\"World\")"sv);
+  REQUIRE(std::ranges::equal(
+      lines, str.to_str() | std::views::split('\n'),
+      [](std::string_view a, auto&& b) {
+        return std::ranges::equal(a, b);
+      }
+  ));
+
+  static_assert(""_i.line_count() == 0);
+  static_assert("single"_i.line_count() == 1);
+  static_assert("single"_i.line(0) == "single"sv);
+
+  // a trailing return ends an empty last line
+  constexpr auto trailing = mitama::unindent::verbatim<"a\n">;
+  static_assert(trailing.line_count() == 2);
+  static_assert(trailing.line(0) == "a"sv);
+  static_assert(trailing.line(1).empty());
+  constexpr auto newline = mitama::unindent::verbatim<"\n">;
+  static_assert(newline.line_count() == 2);
+  static_assert(newline.line(0).empty() and newline.line(1).empty());
+  constexpr auto joined = "x"_i + mitama::unindent::verbatim<"\n\n">;
+  static_assert(joined.line_count() == 3);
+  static_assert(joined.line(0) == "x"sv);
+  static_assert(joined.line(1).empty() and joined.line(2).empty());
+  REQUIRE(std::ranges::equal(
+      joined.lines(), joined.to_str() | std::views::split('\n'),
+      [](std::string_view a, auto&& b) {
+        return std::ranges::equal(a, b);
+      }
+  ));
+}
+
+TEST_CASE("indented#1", "[indented]") {
+  using namespace std::literals;
+  constexpr auto str = mitama::unindent::indented<
+      R"(
+        def foo():
+          pass
+
+        x = 1
+      )",
+      4>;
+  static_assert(str == "    def foo():\n      pass\n\n    x = 1"sv);
+  static_assert(str.size() == 36);
+}
+
+TEST_CASE("reindent#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto body = R"(
+    if (x) {
+      return y;
+
+    }
+  )"_i;
+  constexpr auto expected = "if (x) {\n      return y;\n\n    }"sv;
+
+  std::string str;
+  body.reindent(4).copy_to(std::back_inserter(str));
+  REQUIRE(str == expected);
+  REQUIRE(body.reindent(4).size() == expected.size());
+
+  std::ostringstream os;
+  os << body.reindent(0);
+  REQUIRE(os.str() == body.to_str());
+}
+
+TEST_CASE("reindent#2", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  // the reindented string, checked against the size of the view
+  auto reindented = [](auto view) {
+    std::string str;
+    view.copy_to(std::back_inserter(str));
+    REQUIRE(view.size() == str.size());
+    return str;
+  };
+
+  // fragments joined with a return
+  constexpr auto trailing = "x"_i + mitama::unindent::verbatim<"\n">;
+  REQUIRE(reindented(trailing.reindent(4)) == "x\n"sv);
+  REQUIRE(reindented((trailing + "y"_i).reindent(2)) == "x\n  y"sv);
+
+  // empty lines
+  constexpr auto blank = mitama::unindent::verbatim<"a\n\n\nb\n">;
+  REQUIRE(reindented(blank.reindent(2)) == "a\n\n\n  b\n"sv);
+  REQUIRE(reindented(mitama::unindent::verbatim<"\n">.reindent(3)) == "\n"sv);
+}
+
+TEST_CASE("concat#1", "[edited_string]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto select = R"(
+    SELECT name
+    FROM users
+  )"_i;
+  constexpr auto where = R"(
+    WHERE id = {}
+  )"_i1;
+  constexpr auto query = select + mitama::unindent::verbatim<" "> + where;
+  static_assert(query == "SELECT name\nFROM users WHERE id = {}"sv);
+  REQUIRE(query.format(7) == "SELECT name\nFROM users WHERE id = 7"sv);
+
+  // the joined string has one type (and storage)
+  static_assert(std::same_as<
+                decltype(mitama::unindent::concat<"ab"_i, "c"_i>),
+                decltype(mitama::unindent::concat<"a"_i, "bc"_i>)>);
+  static_assert(mitama::unindent::concat<select>.to_str() == select.to_str());
+}
+
+namespace
+{
+constexpr unsigned char embedded_bytes[] = { '\n', ' ', ' ', 'a', '\n', ' ',
+                                             ' ', ' ', ' ', 'b', '\n', 0 };
+constexpr std::array<std::byte, 3> embedded_array = {
+  std::byte{ 'x' }, std::byte{ 0 }, std::byte{ 'y' }
+};
+} // namespace
+
+TEST_CASE("chunks#1", "[fixed_string]") {
+  using namespace std::literals;
+  // the indent and the lines are those of the joined string
+  constexpr auto joined = mitama::unindent::unindented<
+      mitama::unindent::chunks<"\n    SELECT na", "me\n      FROM users\n">>;
+  static_assert(joined == "SELECT name\n  FROM users"sv);
+  static_assert(std::same_as<
+                decltype(joined),
+                decltype(mitama::unindent::unindented<
+                         "\n    SELECT name\n      FROM users\n">)>);
+  static_assert(mitama::unindent::chunks<"a">.to_str() == "a"sv);
+  static_assert(mitama::unindent::chunks<u8"a", u8"b">.to_str() == u8"ab"sv);
+
+  // a trailing null character is dropped
+  constexpr auto embedded = mitama::unindent::embedded<embedded_bytes>;
+  static_assert(embedded.size == 11);
+  static_assert(mitama::unindent::folded<embedded> == "a   b"sv);
+  static_assert(mitama::unindent::embedded<embedded_array>.size == 3);
+  REQUIRE(mitama::unindent::unindented<embedded>.to_str() == "a\n  b"sv);
+}
+
+TEST_CASE("hash#1", "[edited_string]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto query = R"(
+    SELECT * FROM users
+    WHERE id = ?
+  )"_i;
+  constexpr mitama::unindent::string_hash hasher;
+  static_assert(query.hash() == hasher(query.to_str()));
+  static_assert(hasher(""sv) == 0xcbf29ce484222325 || sizeof(std::size_t) < 8);
+  REQUIRE(std::hash<std::remove_cvref_t<decltype(query)>>{}(query)
+          == query.hash());
+  REQUIRE(hasher(std::string(query.to_str())) == query.hash());
+
+  std::unordered_map<
+      std::string, int, mitama::unindent::string_hash, std::equal_to<>>
+      cache;
+  cache.emplace(query.to_str(), 1);
+  REQUIRE(cache.find(query) != cache.end());
+  REQUIRE(cache.find(query)->second == 1);
+  REQUIRE(cache.find("SELECT *"_i) == cache.end());
+
+  static_assert(query == query);
+  static_assert(query != "SELECT * FROM users"_i);
+  static_assert("abc"_i == R"(
+    abc
+  )"_i);
+}
+
+TEST_CASE("match#1", "[edited_string]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  using mitama::unindent::match;
+  static_assert(match<"GET"_i, "PUT"_i, "DELETE"_i>("PUT") == 1);
+  static_assert(match<"GET"_i, "PUT"_i, "DELETE"_i>("POST") == 3);
+  static_assert(match<"only"_i>("only") == 0);
+
+  const std::string methods[] = { "GET",   "HEAD",    "POST",  "PUT",
+                                  "PATCH", "OPTIONS", "TRACE", "CONNECT" };
+  for (std::size_t i = 0; i < std::size(methods); ++i) {
+    REQUIRE(
+        match<"GET"_i, "HEAD"_i, "POST"_i, "PUT"_i, "PATCH"_i, "OPTIONS"_i,
+              "TRACE"_i, "CONNECT"_i>(methods[i])
+        == i
+    );
+  }
+  REQUIRE(match<"GET"_i, "HEAD"_i>("") == 2);
+  REQUIRE(match<"GET"_i, "HEAD"_i>("GETS") == 2);
+}
+
+TEST_CASE("minified#1", "[minified]") {
+  using namespace mitama::unindent::literals;
+  using namespace std::literals;
+  constexpr auto query = R"(
+    SELECT id, name -- the columns
+      FROM users /* all of them */
+     WHERE name = 'John  -- Doe' AND "odd  id" > - -1
+       AND x = 1 /*+ INDEX(users) */ ;
+  )"_isql;
+  static_assert(
+      query.to_str()
+      == "SELECT id,name FROM users WHERE name = 'John  -- Doe' AND "
+         "\"odd  id\" > - -1 AND x = 1 /*+ INDEX(users) */;"sv
+  );
+  constexpr auto count = R"(
+    SELECT
+      COUNT (*)  /**/ FROM t -- x
+  )"_isql;
+  static_assert(count.to_str() == "SELECT COUNT(*)FROM t"sv);
+  static_assert("a / b - c"_isql.to_str() == "a / b - c"sv);
+
+  constexpr auto body = R"(
+    {
+      "name": "John  \"J\"  Doe",
+      "tags": [ 1, 2 ]
+    }
+  )"_ijson;
+  static_assert(
+      body.to_str() == R"({"name":"John  \"J\"  Doe","tags":[1,2]})"sv
+  );
+  static_assert(body.size() == body.to_str().size());
+}
+
+TEST_CASE("char types#1", "[edited_string]") {
+  using namespace mitama::unindent::literals;
+  using namespace std::literals;
+  constexpr auto u8str = u8R"(
+    def foo():
+      print("Hello")
+  )"_i;
+  static_assert(u8str.to_str() == u8"def foo():\n  print(\"Hello\")"sv);
+  static_assert(u8str.line(1) == u8"  print(\"Hello\")"sv);
+  constexpr auto u16str = uR"(
+    cmake
+    -B build
+  )"_i1;
+  static_assert(u16str.to_str() == u"cmake -B build"sv);
+  static_assert(UR"( { "a" : 1 } )"_ijson.to_str() == U"{\"a\":1}"sv);
+  static_assert((u8"a"_i + u8"b"_i).to_str() == u8"ab"sv);
+
+  std::wostringstream os;
+  os << LR"(
+    Hello,
+  )"_i << mitama::unindent::basic_fixed_string(L" World");
+  REQUIRE(os.str() == L"Hello, World");
+}
+
 // iterator test
 TEST_CASE("iterator#1", "[folded]") {
   using namespace std::literals;
@@ -151,3 +552,155 @@ TEST_CASE("i1v#1", "[folded]") {
 
   static_assert(sv == "first second"sv);
 }
+
+// custom editor whose buffer is larger than the original string
+inline constexpr auto exclaimed =
+    []<typename CharT, std::size_t N>(std::array<CharT, N> raw) consteval {
+      std::array<CharT, N * 2> buffer = {};
+      std::size_t index = 0;
+      for (auto c : raw) {
+        if (c == '\0')
+          break;
+        buffer[index++] = c;
+      }
+      buffer[index] = '!';
+      return buffer;
+    };
+
+TEST_CASE("custom editor#1", "[edited_string]") {
+  using namespace std::literals;
+  constexpr auto str = mitama::unindent::edited_string<"abc", exclaimed>{};
+
+  static_assert(str == "abc!"sv);
+  static_assert(str.to_str().size() == 4);
+}
+
+TEST_CASE("size#1", "[unindented]") {
+  using namespace std::literals;
+  using namespace mitama::unindent::literals;
+  constexpr auto str = R"(
+    first
+    second
+  )"_i;
+
+  static_assert(str.size() == "first\nsecond"sv.size());
+  static_assert(str.data() == str.c_str());
+  static_assert(str.c_str()[str.size()] == '\0');
+  static_assert(std::ranges::distance(str) == str.size());
+  REQUIRE(std::string_view(str.c_str()) == str);
+}
+
+// custom editor built on top of the shared unindent pass
+inline constexpr auto to_shouted = mitama::unindent::details::on_unindented<
+    []<typename CharT, std::size_t N>(std::array<CharT, N> unindented
+    ) consteval {
+      for (auto& c : unindented) {
+        if ('a' <= c and c <= 'z')
+          c = c - 'a' + 'A';
+      }
+      return unindented;
+    }>{};
+
+TEST_CASE("custom editor#2", "[edited_string]") {
+  using namespace std::literals;
+  namespace details = mitama::unindent::details;
+  constexpr auto str = mitama::unindent::edited_string<
+      R"(
+    def foo():
+      print("Hello")
+  )",
+      to_shouted>{};
+
+  static_assert(str == "DEF FOO():\n  PRINT(\"HELLO\")"sv);
+  static_assert(
+      details::view_of(details::unindented_buffer<R"(
+    def foo():
+      print("Hello")
+  )">) == "def foo():\n  print(\"Hello\")"sv
+  );
+}
+
+// per-character stages fused by compose
+struct strip_trailing_spaces
+    : mitama::unindent::char_stage<strip_trailing_spaces>
+{
+  struct state
+  {
+    std::size_t spaces = 0;
+  };
+
+  template <typename CharT>
+  constexpr void feed(state& st, CharT c, auto emit) const {
+    if (c == ' ') {
+      ++st.spaces;
+      return;
+    }
+    if (c != '\n') {
+      for (; st.spaces > 0; --st.spaces)
+        emit(CharT(' '));
+    }
+    st.spaces = 0;
+    emit(c);
+  }
+
+  constexpr void finish(state&, auto) const {}
+};
+
+struct collapse_blank_lines
+    : mitama::unindent::char_stage<collapse_blank_lines>
+{
+  struct state
+  {
+    std::size_t returns = 0;
+  };
+
+  template <typename CharT>
+  constexpr void feed(state& st, CharT c, auto emit) const {
+    st.returns = c == '\n' ? st.returns + 1 : 0;
+    if (st.returns <= 2)
+      emit(c);
+  }
+
+  constexpr void finish(state&, auto) const {}
+};
+
+TEST_CASE("compose#1", "[compose]") {
+  using namespace std::literals;
+  using mitama::unindent::compose;
+  namespace details = mitama::unindent::details;
+  constexpr auto str = mitama::unindent::edited_string<
+      "\n    a  \n\n\n\n      b \n    c\n",
+      compose<
+          details::to_unindented,
+          strip_trailing_spaces{},
+          collapse_blank_lines{}>>{};
+
+  static_assert(str == "a\n\n  b\nc"sv);
+}
+
+TEST_CASE("compose#2", "[compose]") {
+  using namespace std::literals;
+  using mitama::unindent::compose;
+  using mitama::unindent::edited_string;
+  namespace details = mitama::unindent::details;
+
+  // stages after a non per-character editor
+  static_assert(
+      edited_string<
+          "  a  \n  b",
+          compose<
+              strip_trailing_spaces{},
+              details::to_unindented,
+              details::fold_lines>>{}
+      == "a b"sv
+  );
+  // same as `_i1`
+  static_assert(
+      edited_string<
+          "\n  a\n  b\n\n  c\n",
+          compose<details::to_unindented, details::fold_lines>>{}
+      == mitama::unindent::folded<"\n  a\n  b\n\n  c\n">
+  );
+  // empty composition
+  static_assert(edited_string<" a ", compose<>>{} == " a "sv);
+}
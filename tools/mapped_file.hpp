@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+namespace mitama::unindent::tools
+{
+// This is a copy-on-write memory mapping of a whole file.
+//
+// [Note: The mapping is private, so that the contents can be edited in place
+// (e.g. with `unindent_in_place`) without modifying the file. Only the pages
+// written are copied. — end note]
+class mapped_file
+{
+  char* data_ = nullptr;
+  std::size_t size_ = 0;
+#if defined(_WIN32)
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#endif
+
+public:
+  mapped_file() = default;
+
+  explicit mapped_file(const std::filesystem::path& path) {
+#if defined(_WIN32)
+    file_ = ::CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (file_ == INVALID_HANDLE_VALUE)
+      throw_last_error(path);
+    LARGE_INTEGER size;
+    if (not ::GetFileSizeEx(file_, &size))
+      throw_last_error(path);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ == 0)
+      return;
+    mapping_ =
+        ::CreateFileMappingW(file_, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping_ == nullptr)
+      throw_last_error(path);
+    data_ = static_cast<char*>(::MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0));
+    if (data_ == nullptr)
+      throw_last_error(path);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), path.string());
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path.string());
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      void* data = ::mmap(
+          nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0
+      );
+      if (data == MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path.string());
+      }
+      ::madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<char*>(data);
+    }
+    ::close(fd); // the mapping keeps the file
+#endif
+  }
+
+  mapped_file(mapped_file&& other) noexcept
+      : data_{ std::exchange(other.data_, nullptr) },
+        size_{ std::exchange(other.size_, 0) }
+#if defined(_WIN32)
+        ,
+        file_{ std::exchange(other.file_, INVALID_HANDLE_VALUE) },
+        mapping_{ std::exchange(other.mapping_, nullptr) }
+#endif
+  {
+  }
+
+  mapped_file& operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+      close();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+      file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+      mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+  }
+
+  ~mapped_file() {
+    close();
+  }
+
+  // the contents of the file
+  [[nodiscard]] std::span<char> data() const noexcept {
+    return { data_, size_ };
+  }
+
+  void close() noexcept {
+#if defined(_WIN32)
+    if (data_ != nullptr)
+      ::UnmapViewOfFile(data_);
+    if (mapping_ != nullptr)
+      ::CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+      ::CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+#else
+    if (data_ != nullptr)
+      ::munmap(data_, size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+private:
+#if defined(_WIN32)
+  [[noreturn]] static void throw_last_error(const std::filesystem::path& path) {
+    throw std::system_error(
+        static_cast<int>(::GetLastError()), std::system_category(),
+        path.string()
+    );
+  }
+#endif
+};
+
+// This is an unbuffered output file descriptor (or handle)
+// for large contiguous writes.
+class output_file
+{
+#if defined(_WIN32)
+  HANDLE handle_ = INVALID_HANDLE_VALUE;
+  bool owned_ = false;
+#else
+  int fd_ = -1;
+  bool owned_ = false;
+#endif
+  std::string name_;
+
+public:
+  // the standard output
+  output_file() : name_{ "<stdout>" } {
+#if defined(_WIN32)
+    handle_ = ::GetStdHandle(STD_OUTPUT_HANDLE);
+#else
+    fd_ = STDOUT_FILENO;
+#endif
+  }
+
+  // how `output_file` opens a file
+  enum class creation {
+    truncate, // creates the file, or truncates it if it exists
+    new_file, // creates the file, failing with `file_exists` if it exists
+  };
+
+  // creates `path` (as `how` says)
+  explicit output_file(
+      const std::filesystem::path& path, creation how = creation::truncate
+  )
+      : owned_{ true }, name_{ path.string() } {
+#if defined(_WIN32)
+    handle_ = ::CreateFileW(
+        path.c_str(), GENERIC_WRITE, 0, nullptr,
+        how == creation::new_file ? CREATE_NEW : CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (handle_ == INVALID_HANDLE_VALUE)
+      throw std::system_error(
+          static_cast<int>(::GetLastError()), std::system_category(), name_
+      );
+#else
+    const int flags = how == creation::new_file ? O_EXCL : O_TRUNC;
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | flags, 0644);
+    if (fd_ < 0)
+      throw std::system_error(errno, std::generic_category(), name_);
+#endif
+  }
+
+  output_file(const output_file&) = delete;
+  output_file& operator=(const output_file&) = delete;
+
+  ~output_file() {
+#if defined(_WIN32)
+    if (owned_)
+      ::CloseHandle(handle_);
+#else
+    if (owned_)
+      ::close(fd_);
+#endif
+  }
+
+  // writes all of `chunks` in order (with as few system calls as possible)
+  void write(std::span<const std::span<const char>> chunks) {
+#if defined(_WIN32)
+    for (auto chunk : chunks) {
+      while (not chunk.empty()) {
+        DWORD written = 0;
+        const auto size = static_cast<DWORD>(
+            std::min<std::size_t>(chunk.size(), 1u << 30)
+        );
+        if (not ::WriteFile(handle_, chunk.data(), size, &written, nullptr))
+          throw std::system_error(
+              static_cast<int>(::GetLastError()), std::system_category(), name_
+          );
+        chunk = chunk.subspan(written);
+      }
+    }
+#else
+    constexpr std::size_t max_iov = 1024;
+    ::iovec iov[max_iov];
+    std::size_t first = 0;
+    std::size_t offset = 0; // written bytes of `chunks[first]`
+
+    while (first < chunks.size()) {
+      std::size_t count = 0;
+      for (std::size_t i = first; i < chunks.size() and count < max_iov; ++i) {
+        const std::size_t skip = i == first ? offset : 0;
+        iov[count].iov_base = const_cast<char*>(chunks[i].data() + skip);
+        iov[count].iov_len = chunks[i].size() - skip;
+        ++count;
+      }
+      const ::ssize_t written = ::writev(fd_, iov, static_cast<int>(count));
+      if (written < 0) {
+        if (errno == EINTR)
+          continue;
+        throw std::system_error(errno, std::generic_category(), name_);
+      }
+      // skip the chunks written
+      auto rest = static_cast<std::size_t>(written);
+      while (first < chunks.size() and rest >= chunks[first].size() - offset) {
+        rest -= chunks[first].size() - offset;
+        offset = 0;
+        ++first;
+      }
+      offset += rest;
+    }
+#endif
+  }
+
+  void write(std::span<const char> chunk) {
+    write(std::span<const std::span<const char>>(&chunk, 1));
+  }
+};
+} // namespace mitama::unindent::tools
@@ -0,0 +1,300 @@
+// unindent: applies the `_i` (or `_i1`) editing to files.
+//
+// usage: unindent [-1] [-i] [-j N] [FILE]...
+//        unindent --registry BINARY...
+//
+// Each FILE (or the standard input if none) is edited as `_i` does, or as
+// `_i1` does with `-1`, and written to the standard output in order, or
+// back to FILE with `-i`. Each non-empty result ends with a return, as text
+// files do. Files are memory mapped and edited in parallel.
+//
+// With `--registry`, the edited strings of each BINARY built with
+// `UNINDENT_ENABLE_REGISTRY` are listed from the largest literal, with the
+// number of the strings of the same edited string (to deduplicate).
+
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <unindent/registry.hpp>
+#include <unindent/runtime.hpp>
+#include <vector>
+
+namespace
+{
+namespace tools = mitama::unindent::tools;
+
+struct options
+{
+  bool fold = false;
+  bool in_place = false;
+  bool registry = false;
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::filesystem::path> files;
+};
+
+constexpr std::string_view usage = R"(usage: unindent [-1] [-i] [-j N] [FILE]...
+       unindent --registry BINARY...
+
+Removes the indent of each FILE (or the standard input) as the `_i` literal
+of mitama::unindent does, and writes the results to the standard output.
+
+options:
+  -1, --fold      fold paragraphs into single lines as the `_i1` literal
+  -i, --in-place  write the results back to the files
+  -j N            edit N files in parallel (default: the number of cores)
+  --registry      list the edited strings of each BINARY built with
+                  UNINDENT_ENABLE_REGISTRY (sizes in bytes)
+  -h, --help      show this message
+)";
+
+options
+parse_options(std::span<char*> args) {
+  options opts;
+  bool files_only = false;
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string_view arg = args[i];
+    if (files_only or arg.empty() or arg[0] != '-' or arg == "-") {
+      opts.files.emplace_back(arg);
+    } else if (arg == "--") {
+      files_only = true;
+    } else if (arg == "-1" or arg == "--fold") {
+      opts.fold = true;
+    } else if (arg == "-i" or arg == "--in-place") {
+      opts.in_place = true;
+    } else if (arg == "--registry") {
+      opts.registry = true;
+    } else if (arg == "-j") {
+      if (i + 1 == args.size())
+        throw std::invalid_argument("-j requires a number of jobs");
+      const std::string_view value = args[++i];
+      auto [_, ec] = std::from_chars(
+          value.data(), value.data() + value.size(), opts.jobs
+      );
+      if (ec != std::errc{} or opts.jobs == 0)
+        throw std::invalid_argument("invalid number of jobs: "
+                                    + std::string(value));
+    } else if (arg == "-h" or arg == "--help") {
+      std::cout << usage;
+      std::exit(EXIT_SUCCESS);
+    } else {
+      throw std::invalid_argument("unknown option: " + std::string(arg));
+    }
+  }
+  if (opts.in_place and opts.files.empty())
+    throw std::invalid_argument("-i requires files");
+  if (opts.registry and opts.files.empty())
+    throw std::invalid_argument("--registry requires binaries");
+  return opts;
+}
+
+// edits `buf` in place and returns the result
+std::span<const char>
+edit(std::span<char> buf, bool fold) noexcept {
+  return buf.first(
+      fold ? mitama::unindent::fold_in_place(buf)
+           : mitama::unindent::unindent_in_place(buf)
+  );
+}
+
+constexpr char newline = '\n';
+
+// the return ending a result
+std::span<const char>
+terminator(std::span<const char> result) noexcept {
+  return { &newline, result.empty() ? 0u : 1u };
+}
+
+// runs `task(i)` for `i` in [0, count) on `jobs` threads
+template <class Task>
+void
+parallel_for(std::size_t count, unsigned jobs, Task task) {
+  std::atomic<std::size_t> next = 0;
+  std::exception_ptr error = nullptr;
+  std::atomic_flag failed = ATOMIC_FLAG_INIT;
+
+  auto worker = [&] {
+    for (std::size_t i; (i = next.fetch_add(1)) < count;) {
+      try {
+        task(i);
+      } catch (...) {
+        if (not failed.test_and_set())
+          error = std::current_exception();
+        next = count; // stop the other workers
+      }
+    }
+  };
+
+  std::vector<std::jthread> threads;
+  const auto n = std::min<std::size_t>(jobs, count);
+  for (std::size_t i = 1; i < n; ++i)
+    threads.emplace_back(worker);
+  worker();
+  threads.clear(); // join
+  if (error)
+    std::rethrow_exception(error);
+}
+
+// creates a temporary file next to `path` (not an existing one, with the
+// first free name of `<path>.unindent-tmp`, `<path>.unindent-tmp1`, ...)
+// into `out`, and returns its path
+std::filesystem::path
+create_temporary(
+    const std::filesystem::path& path, std::optional<tools::output_file>& out
+) {
+  constexpr unsigned max_attempts = 100;
+  for (unsigned n = 0;; ++n) {
+    auto tmp = path;
+    tmp += ".unindent-tmp";
+    if (n > 0)
+      tmp += std::to_string(n);
+    try {
+      out.emplace(tmp, tools::output_file::creation::new_file);
+      return tmp;
+    } catch (const std::system_error& e) {
+      if (e.code() != std::errc::file_exists or n + 1 == max_attempts)
+        throw;
+    }
+  }
+}
+
+// writes the edited file to a temporary file and replaces the original
+// (the target of a symbolic link, keeping its permissions)
+//
+// [Note: The temporary file is removed if any step fails, so that the
+// original is left as it was. — end note]
+void
+edit_in_place(const std::filesystem::path& file_path, bool fold) {
+  const auto path = std::filesystem::canonical(file_path);
+  tools::mapped_file file(path);
+  std::optional<tools::output_file> out;
+  const auto tmp = create_temporary(path, out);
+  try {
+    const auto result = edit(file.data(), fold);
+    const std::span<const char> chunks[] = { result, terminator(result) };
+    out->write(chunks);
+    out.reset(); // closed before it is renamed
+    file.close();
+    std::filesystem::permissions(
+        tmp, std::filesystem::status(path).permissions()
+    );
+    std::filesystem::rename(tmp, path);
+  } catch (...) {
+    out.reset();
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+    throw;
+  }
+}
+
+// the number of files mapped at a time when writing to the standard output
+constexpr std::size_t batch_size = 256;
+
+void
+edit_to_stdout(const options& opts) {
+  tools::output_file out;
+  std::vector<tools::mapped_file> files(batch_size);
+  // the results and their terminators
+  std::vector<std::span<const char>> chunks(batch_size * 2);
+
+  for (std::size_t first = 0; first < opts.files.size(); first += batch_size) {
+    const auto count = std::min(batch_size, opts.files.size() - first);
+    parallel_for(count, opts.jobs, [&](std::size_t i) {
+      files[i] = tools::mapped_file(opts.files[first + i]);
+      chunks[i * 2] = edit(files[i].data(), opts.fold);
+      chunks[i * 2 + 1] = terminator(chunks[i * 2]);
+    });
+    out.write(std::span(chunks).first(count * 2));
+    for (auto& file : files)
+      file.close();
+  }
+}
+
+void
+edit_stdin(const options& opts) {
+  std::cin.tie(nullptr);
+  std::string text(
+      std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>{}
+  );
+  const auto result = edit(text, opts.fold);
+  const std::span<const char> chunks[] = { result, terminator(result) };
+  tools::output_file out;
+  out.write(chunks);
+}
+
+// lists the edited strings registered in each binary of `opts.files`
+void
+list_registry(const options& opts) {
+  for (const auto& path : opts.files) {
+    const tools::mapped_file file(path);
+    auto entries = mitama::unindent::scan_registry(file.data());
+    std::ranges::sort(entries, [](const auto& lhs, const auto& rhs) {
+      return lhs.raw_size * lhs.char_size > rhs.raw_size * rhs.char_size;
+    });
+    // the number of the entries of each edited string
+    using key = std::tuple<std::uint64_t, std::uint64_t, std::uint8_t>;
+    std::map<key, std::size_t> copies;
+    for (const auto& e : entries)
+      ++copies[key{ e.hash, e.edited_size, e.char_size }];
+
+    std::uint64_t raw_total = 0, edited_total = 0;
+    std::cout << path.string() << ": " << entries.size() << " literals\n"
+              << std::setw(10) << "raw" << std::setw(10) << "edited"
+              << std::setw(7) << "copies" << "  " << std::left
+              << std::setw(14) << "editor" << std::setw(17) << "hash"
+              << "first line\n"
+              << std::right;
+    for (const auto& e : entries) {
+      raw_total += e.raw_size * e.char_size;
+      edited_total += e.edited_size * e.char_size;
+      std::cout << std::setw(10) << e.raw_size * e.char_size << std::setw(10)
+                << e.edited_size * e.char_size << std::setw(7)
+                << copies[key{ e.hash, e.edited_size, e.char_size }] << "  "
+                << std::left << std::setw(14)
+                << mitama::unindent::name_of(e.editor) << std::hex
+                << std::setfill('0') << std::right << std::setw(16) << e.hash
+                << std::dec << std::setfill(' ') << ' ' << e.preview_view()
+                << '\n';
+    }
+    std::cout << "total: " << raw_total << " bytes of literals, "
+              << edited_total << " bytes of edited strings\n";
+  }
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+  try {
+    const auto opts = parse_options(std::span(argv, argc).subspan(1));
+    if (opts.registry) {
+      list_registry(opts);
+    } else if (opts.files.empty()) {
+      edit_stdin(opts);
+    } else if (opts.in_place) {
+      parallel_for(opts.files.size(), opts.jobs, [&](std::size_t i) {
+        edit_in_place(opts.files[i], opts.fold);
+      });
+    } else {
+      edit_to_stdout(opts);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "unindent: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}